@@ -2,9 +2,11 @@
 # This software may be modified and distributed under the terms of the
 # GNU Lesser General Public License v2.1 or any later version.
 
+import struct
 from dataclasses import dataclass, field
-from typing import Iterable, List, Tuple
+from typing import Iterable, List, Sequence, Tuple
 
+import numpy as np
 from gym_ignition.context.gazebo import plugin
 
 GRAVITY = (0, 0, -9.80665)
@@ -20,6 +22,13 @@ class ComputedTorqueFixedBase(plugin.GazeboPlugin):
     joints: List[str]
     gravity: Tuple[float, float, float] = field(default_factory=lambda: GRAVITY)
 
+    # Recomputation periods of the dynamics quantities (0: every step)
+    mass_matrix_period: float = 0.0
+    bias_forces_period: float = 0.0
+
+    # Print the timing statistics of the controller when it is destroyed
+    print_statistics: bool = False
+
     # Private fields
     _name: str = field(init=False, repr=False, default="ComputedTorqueFixedBase")
     _plugin_name: str = field(init=False, repr=False, default="ControllerRunner")
@@ -36,6 +45,9 @@ class ComputedTorqueFixedBase(plugin.GazeboPlugin):
             <urdf>{self.urdf}</urdf>
             <joints>{self._to_str(self.joints)}</joints>
             <gravity>{self._to_str(self.gravity)}</gravity>
+            <mass_matrix_period>{self.mass_matrix_period}</mass_matrix_period>
+            <bias_forces_period>{self.bias_forces_period}</bias_forces_period>
+            <print_statistics>{str(self.print_statistics).lower()}</print_statistics>
         </controller>
         """
 
@@ -45,3 +57,114 @@ class ComputedTorqueFixedBase(plugin.GazeboPlugin):
     def _to_str(iterable: Iterable) -> str:
 
         return " ".join([str(el) for el in iterable])
+
+
+@dataclass
+class MLPPolicy(plugin.GazeboPlugin):
+    """
+    Feed-forward policy evaluated by the ControllerRunner at every controller period.
+
+    The observation is the vector of positions and velocities of the controlled joints,
+    optionally followed by the base orientation (wxyz) and the base linear and angular
+    velocities in the base frame. The output is applied either as joint torques or as
+    joint position targets. Empty normalization vectors are the identity.
+
+    The weights file can be created from NumPy arrays with :py:meth:`write_weights`.
+    """
+
+    weights: str
+    joints: List[str] = field(default_factory=list)
+    output: str = "torque"
+    base_observation: bool = False
+
+    observation_offset: List[float] = field(default_factory=list)
+    observation_scale: List[float] = field(default_factory=list)
+    action_offset: List[float] = field(default_factory=list)
+    action_scale: List[float] = field(default_factory=list)
+
+    # Print the timing statistics of the controller when it is destroyed
+    print_statistics: bool = False
+
+    # Private fields
+    _name: str = field(init=False, repr=False, default="MLPPolicy")
+    _plugin_name: str = field(init=False, repr=False, default="ControllerRunner")
+    _plugin_class: str = field(
+        init=False, repr=False, default="scenario::plugins::gazebo::ControllerRunner"
+    )
+
+    # Activations supported by the controller
+    ACTIVATIONS = {"linear": 0, "tanh": 1, "relu": 2, "elu": 3}
+
+    def to_xml(self) -> str:
+
+        optional = {
+            "joints": self.joints,
+            "observation_offset": self.observation_offset,
+            "observation_scale": self.observation_scale,
+            "action_offset": self.action_offset,
+            "action_scale": self.action_scale,
+        }
+
+        elements = "".join(
+            f"<{name}>{ComputedTorqueFixedBase._to_str(value)}</{name}>"
+            for name, value in optional.items()
+            if len(value) > 0
+        )
+
+        xml = f"""
+        <controller name="{self._name}">
+            <weights>{self.weights}</weights>
+            <output>{self.output}</output>
+            <base_observation>{str(self.base_observation).lower()}</base_observation>
+            <print_statistics>{str(self.print_statistics).lower()}</print_statistics>
+            {elements}
+        </controller>
+        """
+
+        return xml
+
+    @staticmethod
+    def write_weights(
+        file: str,
+        weights: Sequence[np.ndarray],
+        biases: Sequence[np.ndarray],
+        activations: Sequence[str],
+    ) -> None:
+        """
+        Write the parameters of a feed-forward network to a weights file.
+
+        Args:
+            file: The path of the weights file.
+            weights: The weight matrices of the layers with shape (outputs, inputs).
+            biases: The bias vectors of the layers with shape (outputs,).
+            activations: The activations of the layers ("linear", "tanh", "relu",
+                "elu").
+        """
+
+        if not len(weights) == len(biases) == len(activations):
+            raise ValueError("The number of weights, biases and activations differ")
+
+        with open(file, "wb") as f:
+
+            f.write(b"SMLP")
+            f.write(struct.pack("<II", 1, len(weights)))
+
+            for w, b, activation in zip(weights, biases, activations):
+
+                w = np.asarray(w, dtype="<f4")
+                b = np.asarray(b, dtype="<f4")
+
+                if w.ndim != 2 or b.shape != (w.shape[0],):
+                    raise ValueError("Wrong shape of the layer parameters")
+
+                if activation not in MLPPolicy.ACTIVATIONS:
+                    raise ValueError(f"Activation '{activation}' not supported")
+
+                outputs, inputs = w.shape
+                f.write(
+                    struct.pack(
+                        "<III", inputs, outputs, MLPPolicy.ACTIVATIONS[activation]
+                    )
+                )
+                f.write(np.ascontiguousarray(w).tobytes())
+                f.write(b.tobytes())
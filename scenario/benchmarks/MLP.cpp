@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This project is dual licensed under LGPL v2.1+ or Apache License.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmark of the inference latency of the networks evaluated by the
+// MLPPolicy controller.
+//
+// Networks of typical locomotion and manipulation policies are evaluated
+// with the blocked kernel of the MLP class and with a naive row-major
+// implementation, reporting the latency of a single call.
+
+#include "scenario/controllers/MLP.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    using scenario::controllers::Activation;
+    using scenario::controllers::MLP;
+
+    struct Architecture
+    {
+        std::string name;
+        std::vector<size_t> sizes;
+    };
+
+    struct Layer
+    {
+        size_t inputs;
+        size_t outputs;
+        std::vector<float> weights;
+        std::vector<float> bias;
+    };
+
+    // Naive evaluation with row-major weights and dot-product reductions
+    class NaiveMLP
+    {
+    public:
+        void addLayer(Layer layer) { m_layers.push_back(std::move(layer)); }
+
+        void evaluate(const std::vector<float>& input, std::vector<float>& out)
+        {
+            m_input = input;
+
+            for (size_t l = 0; l < m_layers.size(); ++l) {
+                const auto& layer = m_layers[l];
+                m_output.resize(layer.outputs);
+
+                for (size_t row = 0; row < layer.outputs; ++row) {
+                    float value = layer.bias[row];
+
+                    for (size_t col = 0; col < layer.inputs; ++col) {
+                        value += layer.weights[row * layer.inputs + col]
+                                 * m_input[col];
+                    }
+
+                    // Hidden layers use tanh, the last one is linear
+                    m_output[row] =
+                        l + 1 < m_layers.size() ? std::tanh(value) : value;
+                }
+
+                std::swap(m_input, m_output);
+            }
+
+            out = m_input;
+        }
+
+    private:
+        std::vector<Layer> m_layers;
+        std::vector<float> m_input;
+        std::vector<float> m_output;
+    };
+
+    constexpr size_t NumOfCalls = 20000;
+
+    template <typename Function>
+    double elapsedSeconds(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+} // namespace
+
+int main()
+{
+    const std::vector<Architecture> architectures = {
+        {"48-64-64-12", {48, 64, 64, 12}},
+        {"48-256-256-12", {48, 256, 256, 12}},
+        {"128-512-256-128-23", {128, 512, 256, 128, 23}},
+    };
+
+    std::mt19937 generator(42);
+    std::normal_distribution<float> distribution(0.0f, 0.1f);
+    double checksum = 0.0;
+
+    std::cout << std::setw(24) << "network" << std::setw(16) << "naive"
+              << std::setw(16) << "blocked" << std::endl;
+
+    for (const auto& architecture : architectures) {
+        MLP mlp;
+        NaiveMLP naive;
+
+        const auto& sizes = architecture.sizes;
+
+        for (size_t l = 0; l + 1 < sizes.size(); ++l) {
+            Layer layer{sizes[l], sizes[l + 1], {}, {}};
+            layer.weights.resize(layer.inputs * layer.outputs);
+            layer.bias.resize(layer.outputs);
+
+            for (auto& w : layer.weights) {
+                w = distribution(generator);
+            }
+
+            for (auto& b : layer.bias) {
+                b = distribution(generator);
+            }
+
+            const bool last = l + 2 == sizes.size();
+            mlp.addLayer(layer.inputs,
+                         layer.outputs,
+                         layer.weights,
+                         layer.bias,
+                         last ? Activation::Linear : Activation::Tanh);
+            naive.addLayer(std::move(layer));
+        }
+
+        std::vector<float> input(sizes.front());
+        std::vector<float> output;
+
+        for (auto& value : input) {
+            value = distribution(generator);
+        }
+
+        const double naiveTime = elapsedSeconds([&]() {
+            for (size_t call = 0; call < NumOfCalls; ++call) {
+                input[call % input.size()] += 1e-6f;
+                naive.evaluate(input, output);
+                checksum += output.front();
+            }
+        });
+
+        const double blockedTime = elapsedSeconds([&]() {
+            for (size_t call = 0; call < NumOfCalls; ++call) {
+                input[call % input.size()] += 1e-6f;
+                mlp.evaluate(input, output);
+                checksum += output.front();
+            }
+        });
+
+        const auto format = [](const double seconds) {
+            std::cout << std::setw(11) << std::fixed << std::setprecision(3)
+                      << seconds * 1e6 / NumOfCalls << " us";
+        };
+
+        std::cout << std::setw(24) << architecture.name << "  ";
+        format(naiveTime);
+        std::cout << "  ";
+        format(blockedTime);
+        std::cout << std::endl;
+    }
+
+    // Prevent the compiler from optimizing away the calls
+    std::cout << "checksum: " << checksum << std::endl;
+
+    return 0;
+}
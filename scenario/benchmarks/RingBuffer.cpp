@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This project is dual licensed under LGPL v2.1+ or Apache License.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmark of the ring buffer that stores the history of the joint signals
+// against the deque-based queue that it replaced.
+//
+// The history of a model with many DoFs is filled for a number of steps
+// and read after every step, as it happens when the history is queried by
+// the environments at every agent step.
+
+#include "scenario/gazebo/helpers.h"
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace {
+    // The deque-based queue previously used by the history component
+    class DequeQueue
+    {
+    public:
+        DequeQueue(const size_t size)
+            : m_size(size)
+            , m_deque(size, 0.0)
+        {}
+
+        void push(const double value)
+        {
+            if (m_deque.size() == m_size) {
+                m_deque.pop_front();
+            }
+
+            m_deque.push_back(value);
+        }
+
+        std::vector<double> toStdVector() const
+        {
+            return {m_deque.begin(), m_deque.end()};
+        }
+
+    private:
+        size_t m_size;
+        std::deque<double> m_deque;
+    };
+
+    constexpr size_t NumOfJoints = 50;
+    constexpr size_t HistorySize = 100;
+    constexpr size_t NumOfSteps = 100000;
+
+    template <typename Function>
+    double elapsedSeconds(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+} // namespace
+
+int main()
+{
+    using scenario::gazebo::utils::RingBuffer;
+
+    std::vector<double> row(NumOfJoints);
+    double checksum = 0.0;
+
+    // Push a single value per joint and copy the history at every step
+    std::vector<DequeQueue> deques(NumOfJoints, DequeQueue(HistorySize));
+
+    const double dequeTime = elapsedSeconds([&]() {
+        for (size_t step = 0; step < NumOfSteps; ++step) {
+            for (size_t j = 0; j < NumOfJoints; ++j) {
+                deques[j].push(static_cast<double>(step + j));
+            }
+
+            for (const auto& deque : deques) {
+                checksum += deque.toStdVector().back();
+            }
+        }
+    });
+
+    // Push a single value per joint and read the history through the spans
+    std::vector<RingBuffer> ringBuffers(NumOfJoints, RingBuffer(HistorySize));
+
+    const double ringBufferTime = elapsedSeconds([&]() {
+        for (size_t step = 0; step < NumOfSteps; ++step) {
+            for (size_t j = 0; j < NumOfJoints; ++j) {
+                const double value = static_cast<double>(step + j);
+                ringBuffers[j].push(&value);
+            }
+
+            for (const auto& ringBuffer : ringBuffers) {
+                const auto [first, second] = ringBuffer.spans();
+                checksum += second.size > 0 ? second.data[second.size - 1]
+                                            : first.data[first.size - 1];
+            }
+        }
+    });
+
+    // Push the values of all the joints in bulk and read through the spans
+    RingBuffer bulkRingBuffer(HistorySize, NumOfJoints);
+
+    const double bulkRingBufferTime = elapsedSeconds([&]() {
+        for (size_t step = 0; step < NumOfSteps; ++step) {
+            std::iota(row.begin(), row.end(), static_cast<double>(step));
+            bulkRingBuffer.push(row);
+
+            const auto [first, second] = bulkRingBuffer.spans();
+            checksum += std::accumulate(first.data, first.data + first.size, 0.0)
+                        + std::accumulate(
+                            second.data, second.data + second.size, 0.0);
+        }
+    });
+
+    const auto print = [](const char* name, const double seconds) {
+        std::cout << std::setw(24) << name << std::setw(14) << std::fixed
+                  << std::setprecision(3) << seconds * 1e9 / NumOfSteps
+                  << " ns/step" << std::endl;
+    };
+
+    std::cout << NumOfJoints << " joints, " << HistorySize
+              << " steps of history, " << NumOfSteps << " steps" << std::endl;
+
+    print("deque", dequeTime);
+    print("ring buffer", ringBufferTime);
+    print("ring buffer (bulk)", bulkRingBufferTime);
+
+    // Prevent the compiler from optimizing away the reads
+    std::cout << "checksum: " << checksum << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,279 @@
+// Exchange of contiguous arrays of doubles with Python objects implementing
+// the buffer protocol, like numpy.ndarray objects with dtype float64.
+//
+// - Input arguments of type std::vector<double> and std::array<double, N>
+//   accept any C-contiguous 1D buffer of doubles and copy it with a single
+//   memcpy. Other objects fall back to the default sequence conversion.
+// - The helpers of the scenario::bindings namespace are used by the methods
+//   that write outputs into preallocated buffers.
+// - Read-only views of C++ memory are exported by an object that holds a
+//   shared owner of the memory, which is kept alive as long as any view or
+//   array created from it exists.
+
+%{
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace scenario::bindings {
+    class DoubleBuffer
+    {
+    public:
+        DoubleBuffer(PyObject* obj, const bool writable = false)
+        {
+            if (!obj || !PyObject_CheckBuffer(obj)) {
+                return;
+            }
+
+            // Without PyBUF_STRIDES the exporter must provide a C-contiguous
+            // buffer, otherwise the request fails
+            const int flags =
+                PyBUF_ND | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0);
+
+            if (PyObject_GetBuffer(obj, &m_view, flags) != 0) {
+                PyErr_Clear();
+                return;
+            }
+
+            m_acquired = true;
+            m_valid = m_view.ndim == 1
+                      && m_view.itemsize == sizeof(double)
+                      && isDoubleFormat(m_view.format);
+        }
+
+        ~DoubleBuffer()
+        {
+            if (m_acquired) {
+                PyBuffer_Release(&m_view);
+            }
+        }
+
+        DoubleBuffer(const DoubleBuffer&) = delete;
+        DoubleBuffer& operator=(const DoubleBuffer&) = delete;
+
+        inline bool valid() const { return m_valid; }
+        inline size_t size() const { return m_view.len / sizeof(double); }
+        inline double* data() const { return static_cast<double*>(m_view.buf); }
+
+    private:
+        static bool isDoubleFormat(const char* format)
+        {
+            if (!format) {
+                return false;
+            }
+
+            const std::string f(format);
+
+            // Native, standard native, and little-endian (all our platforms)
+            return f == "d" || f == "@d" || f == "=d" || f == "<d";
+        }
+
+        Py_buffer m_view = {};
+        bool m_acquired = false;
+        bool m_valid = false;
+    };
+
+    inline bool assign(std::vector<double>& output, const DoubleBuffer& buffer)
+    {
+        output.assign(buffer.data(), buffer.data() + buffer.size());
+        return true;
+    }
+
+    template <size_t N>
+    inline bool assign(std::array<double, N>& output,
+                       const DoubleBuffer& buffer)
+    {
+        if (buffer.size() != N) {
+            return false;
+        }
+
+        std::copy_n(buffer.data(), N, output.begin());
+        return true;
+    }
+
+    template <typename T>
+    inline void copyToBuffer(const T& data, PyObject* output)
+    {
+        DoubleBuffer buffer(output, /*writable=*/true);
+
+        if (!buffer.valid()) {
+            throw std::invalid_argument(
+                "The output must be a writable C-contiguous 1D buffer of "
+                "float64");
+        }
+
+        if (buffer.size() != data.size()) {
+            throw std::invalid_argument(
+                "The output buffer has size " + std::to_string(buffer.size())
+                + " while " + std::to_string(data.size())
+                + " elements are required");
+        }
+
+        std::copy(data.begin(), data.end(), buffer.data());
+    }
+
+    // Exporter of a read-only 1D buffer of doubles. The memoryview objects
+    // created from it reference the exporter, that holds the owner of the
+    // memory.
+    struct SharedDoubleBuffer
+    {
+        PyObject_HEAD
+        std::shared_ptr<const void>* owner;
+        const double* data;
+        Py_ssize_t shape[1];
+        Py_ssize_t strides[1];
+    };
+
+    inline int
+    sharedDoubleBufferGet(PyObject* self, Py_buffer* view, const int flags)
+    {
+        auto* buffer = reinterpret_cast<SharedDoubleBuffer*>(self);
+
+        if (flags & PyBUF_WRITABLE) {
+            PyErr_SetString(PyExc_BufferError, "The buffer is read-only");
+            return -1;
+        }
+
+        Py_INCREF(self);
+        view->obj = self;
+        view->buf = const_cast<double*>(buffer->data);
+        view->len = buffer->shape[0] * static_cast<Py_ssize_t>(sizeof(double));
+        view->readonly = 1;
+        view->itemsize = sizeof(double);
+        view->format =
+            (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+        view->ndim = 1;
+        view->shape = (flags & PyBUF_ND) ? buffer->shape : nullptr;
+        view->strides =
+            ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? buffer->strides
+                                                       : nullptr;
+        view->suboffsets = nullptr;
+        view->internal = nullptr;
+        return 0;
+    }
+
+    inline void sharedDoubleBufferDealloc(PyObject* self)
+    {
+        auto* buffer = reinterpret_cast<SharedDoubleBuffer*>(self);
+        delete buffer->owner;
+
+        PyTypeObject* type = Py_TYPE(self);
+        type->tp_free(self);
+        Py_DECREF(type);
+    }
+
+    inline PyTypeObject* sharedDoubleBufferType()
+    {
+        static PyType_Slot slots[] = {
+            {Py_tp_dealloc,
+             reinterpret_cast<void*>(sharedDoubleBufferDealloc)},
+            {Py_bf_getbuffer, reinterpret_cast<void*>(sharedDoubleBufferGet)},
+            {0, nullptr},
+        };
+
+        static PyType_Spec spec = {
+            "scenario.bindings.SharedDoubleBuffer",
+            sizeof(SharedDoubleBuffer),
+            0,
+            Py_TPFLAGS_DEFAULT,
+            slots,
+        };
+
+        // Created once and never released
+        static PyObject* type = PyType_FromSpec(&spec);
+        return reinterpret_cast<PyTypeObject*>(type);
+    }
+
+    inline PyObject* readOnlyView(const double* data,
+                                  const size_t size,
+                                  std::shared_ptr<const void> owner)
+    {
+        if (!data || !owner) {
+            Py_RETURN_NONE;
+        }
+
+        PyTypeObject* type = sharedDoubleBufferType();
+
+        if (!type) {
+            return nullptr;
+        }
+
+        auto* buffer = PyObject_New(SharedDoubleBuffer, type);
+
+        if (!buffer) {
+            return nullptr;
+        }
+
+        buffer->owner = new std::shared_ptr<const void>(std::move(owner));
+        buffer->data = data;
+        buffer->shape[0] = static_cast<Py_ssize_t>(size);
+        buffer->strides[0] = sizeof(double);
+
+        PyObject* view =
+            PyMemoryView_FromObject(reinterpret_cast<PyObject*>(buffer));
+        Py_DECREF(buffer);
+        return view;
+    }
+} // namespace scenario::bindings
+%}
+
+%define SCENARIO_DOUBLE_BUFFER_TYPEMAPS(TYPE...)
+%typemap(in) const TYPE& (TYPE temp, int res = SWIG_OLDOBJ) {
+    scenario::bindings::DoubleBuffer buffer($input);
+
+    if (buffer.valid() && scenario::bindings::assign(temp, buffer)) {
+        $1 = &temp;
+    }
+    else {
+        TYPE* ptr = nullptr;
+        res = swig::asptr($input, &ptr);
+        if (!SWIG_IsOK(res) || !ptr) {
+            %argument_fail(res, "$type", $symname, $argnum);
+        }
+        $1 = ptr;
+    }
+}
+
+%typemap(freearg) const TYPE& {
+    if (SWIG_IsNewObj(res$argnum)) {
+        delete $1;
+    }
+}
+
+%typemap(typecheck, precedence=SWIG_TYPECHECK_DOUBLE_ARRAY) const TYPE& {
+    $1 = scenario::bindings::DoubleBuffer($input).valid()
+         || SWIG_IsOK(swig::asptr($input, (TYPE**)0));
+}
+%enddef
+
+SCENARIO_DOUBLE_BUFFER_TYPEMAPS(std::vector<double>)
+SCENARIO_DOUBLE_BUFFER_TYPEMAPS(std::array<double, 3>)
+SCENARIO_DOUBLE_BUFFER_TYPEMAPS(std::array<double, 4>)
+SCENARIO_DOUBLE_BUFFER_TYPEMAPS(std::array<double, 6>)
+
+%typemap(doctype) PyObject* output "numpy.ndarray";
+
+// Add a method <METHOD>Into(output, ...) that writes the output of a getter
+// into a preallocated buffer, without creating new Python objects
+%define SCENARIO_GETTER_INTO_BUFFER(CLASS, METHOD)
+%extend CLASS {
+    void METHOD ## Into(PyObject* output) const
+    {
+        scenario::bindings::copyToBuffer($self->METHOD(), output);
+    }
+}
+%enddef
+
+%define SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(CLASS, METHOD)
+%extend CLASS {
+    void METHOD ## Into(PyObject* output,
+                        const std::vector<std::string>& jointNames = {}) const
+    {
+        scenario::bindings::copyToBuffer($self->METHOD(jointNames), output);
+    }
+}
+%enddef
@@ -1,4 +1,4 @@
-%module(package="scenario.bindings") core
+%module(package="scenario.bindings", threads="1") core
 
 %{
 #define SWIG_FILE_WITH_INIT
@@ -44,6 +44,10 @@
 // Pair instantiation
 %template(PosePair) std::pair<std::array<double, 3>, std::array<double, 4>>;
 
+// Accept buffers (e.g. numpy arrays) as input of vectors and arrays of doubles.
+// Keep it below the instantiation of the std::vector and std::array templates.
+%include "buffers.i"
+
 // ScenarI/O templates
 %template(VectorOfLinks) std::vector<scenario::core::LinkPtr>;
 %template(VectorOfJoints) std::vector<scenario::core::JointPtr>;
@@ -90,6 +94,42 @@ from typing import Tuple
 %shared_ptr(scenario::core::Model)
 %shared_ptr(scenario::core::World)
 
+// Release the GIL in bulk getters. The methods that read from or write into
+// Python objects (e.g. the *Into methods below) must keep holding it.
+%nothread;
+%thread scenario::core::Model::jointPositions;
+%thread scenario::core::Model::jointVelocities;
+%thread scenario::core::Model::jointAccelerations;
+%thread scenario::core::Model::jointGeneralizedForces;
+%thread scenario::core::Model::jointPositionTargets;
+%thread scenario::core::Model::jointVelocityTargets;
+%thread scenario::core::Model::jointAccelerationTargets;
+%thread scenario::core::Model::jointGeneralizedForceTargets;
+%thread scenario::core::Model::historyOfAppliedJointForces;
+%thread scenario::core::Model::contacts;
+
+// Getters that write into preallocated buffers
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointPositions)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointVelocities)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointAccelerations)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointGeneralizedForces)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointPositionTargets)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointVelocityTargets)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointAccelerationTargets)
+SCENARIO_SERIALIZED_GETTER_INTO_BUFFER(scenario::core::Model, jointGeneralizedForceTargets)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Model, basePosition)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Model, baseOrientation)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Model, baseWorldLinearVelocity)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Model, baseWorldAngularVelocity)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Joint, jointPosition)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Joint, jointVelocity)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Joint, jointAcceleration)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Joint, jointGeneralizedForce)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Link, position)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Link, orientation)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Link, worldLinearVelocity)
+SCENARIO_GETTER_INTO_BUFFER(scenario::core::Link, worldAngularVelocity)
+
 // ScenarI/O core headers
 %include "scenario/core/Joint.h"
 %include "scenario/core/Link.h"
@@ -1,10 +1,11 @@
-%module(package="scenario.bindings") gazebo
+%module(package="scenario.bindings", threads="1") gazebo
 
 %{
 #define SWIG_FILE_WITH_INIT
 #include "scenario/gazebo/GazeboEntity.h"
 #include "scenario/gazebo/GazeboSimulator.h"
 #include "scenario/gazebo/Joint.h"
+#include "scenario/gazebo/JointSelection.h"
 #include "scenario/gazebo/Link.h"
 #include "scenario/gazebo/Model.h"
 #include "scenario/gazebo/utils.h"
@@ -43,6 +44,13 @@ namespace scenario::gazebo::utils {
 // From http://www.swig.org/Doc4.0/Modules.html
 %import "../core/core.i"
 
+// The helpers and typemaps of imported modules are not emitted, include them
+%include "../core/buffers.i"
+
+// Gazebo templates
+%template(VectorOfModelSpecs) std::vector<scenario::gazebo::ModelSpec>;
+%template(VectorOfContactStatistics) std::vector<scenario::gazebo::ContactStatistics>;
+
 // NOTE: Keep all template instantiations above.
 // Rename all methods to undercase with _ separators excluding the classes.
 %rename("%(undercase)s") "";
@@ -57,11 +65,17 @@ namespace scenario::gazebo::utils {
 %rename("") JointType;
 %rename("") Verbosity;
 %rename("") JointLimit;
+%rename("") JointSignal;
 %rename("") ContactPoint;
 %rename("") GazeboEntity;
 %rename("") PhysicsEngine;
 %rename("") GazeboSimulator;
 %rename("") JointControlMode;
+%rename("") JointSelection;
+%rename("") ModelSpec;
+%rename("") SdfCacheStats;
+%rename("") ContactStatistics;
+%rename("") ControllerStatistics;
 
 // Other templates for ScenarI/O APIs
 %shared_ptr(scenario::gazebo::Joint)
@@ -77,6 +91,73 @@ namespace scenario::gazebo::utils {
 %ignore scenario::gazebo::GazeboEntity::eventManager;
 %ignore scenario::gazebo::GazeboEntity::createECMResources;
 
+// Raw pointers to the joint state cache are exposed as read-only memoryviews
+%ignore scenario::gazebo::Model::jointPositionsView;
+%ignore scenario::gazebo::Model::jointVelocitiesView;
+%ignore scenario::gazebo::Model::jointAccelerationsView;
+%ignore scenario::gazebo::Model::jointGeneralizedForcesView;
+%ignore scenario::gazebo::Model::jointStateCacheOwner;
+
+// Zero-copy views of the joint state cache. The returned memoryview objects
+// can be wrapped in numpy arrays without copies (np.asarray). They hold a
+// reference to the cache, that is kept allocated as long as any view or array
+// exists. After the model is removed, they store its last state.
+%extend scenario::gazebo::Model {
+    PyObject* jointPositionsBuffer() const
+    {
+        return scenario::bindings::readOnlyView($self->jointPositionsView(),
+                                                $self->dofs(),
+                                                $self->jointStateCacheOwner());
+    }
+
+    PyObject* jointVelocitiesBuffer() const
+    {
+        return scenario::bindings::readOnlyView($self->jointVelocitiesView(),
+                                                $self->dofs(),
+                                                $self->jointStateCacheOwner());
+    }
+
+    PyObject* jointAccelerationsBuffer() const
+    {
+        return scenario::bindings::readOnlyView(
+            $self->jointAccelerationsView(),
+            $self->dofs(),
+            $self->jointStateCacheOwner());
+    }
+
+    PyObject* jointGeneralizedForcesBuffer() const
+    {
+        return scenario::bindings::readOnlyView(
+            $self->jointGeneralizedForcesView(),
+            $self->dofs(),
+            $self->jointStateCacheOwner());
+    }
+}
+
+// Release the GIL in methods that can take long and that do not interact with
+// Python objects, so that other Python threads can progress in the meantime
+// (e.g. multiple simulators stepped from a thread pool). Note that calling
+// methods of the same simulator from multiple threads is not supported.
+%nothread;
+%thread scenario::gazebo::GazeboSimulator::run;
+%thread scenario::gazebo::GazeboSimulator::initialize;
+%thread scenario::gazebo::GazeboSimulator::insertWorldFromSDF;
+%thread scenario::gazebo::GazeboSimulator::insertWorldsFromSDF;
+%thread scenario::gazebo::World::insertModel;
+%thread scenario::gazebo::World::insertModelFromFile;
+%thread scenario::gazebo::World::insertModelFromString;
+%thread scenario::gazebo::World::insertModels;
+%thread scenario::gazebo::Model::jointPositions;
+%thread scenario::gazebo::Model::jointVelocities;
+%thread scenario::gazebo::Model::jointAccelerations;
+%thread scenario::gazebo::Model::jointGeneralizedForces;
+%thread scenario::gazebo::Model::jointPositionTargets;
+%thread scenario::gazebo::Model::jointVelocityTargets;
+%thread scenario::gazebo::Model::jointAccelerationTargets;
+%thread scenario::gazebo::Model::jointGeneralizedForceTargets;
+%thread scenario::gazebo::Model::historyOfAppliedJointForces;
+%thread scenario::gazebo::Model::contacts;
+
 // Workaround for https://github.com/swig/swig/issues/1830
 %feature("pythonprepend") scenario::gazebo::World::getModel %{
     r"""
@@ -98,6 +179,7 @@ namespace scenario::gazebo::utils {
 // ScenarI/O headers
 %include "scenario/gazebo/Joint.h"
 %include "scenario/gazebo/Link.h"
+%include "scenario/gazebo/JointSelection.h"
 %include "scenario/gazebo/Model.h"
 %include "scenario/gazebo/World.h"
 
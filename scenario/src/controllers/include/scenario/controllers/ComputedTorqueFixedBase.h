@@ -33,12 +33,18 @@ class scenario::controllers::ComputedTorqueFixedBase final
 {
 public:
     ComputedTorqueFixedBase() = delete;
+
+    // The mass matrix and the bias forces are recomputed every
+    // massMatrixPeriod and biasForcesPeriod seconds and cached in between.
+    // A zero period recomputes them at every controller step.
     ComputedTorqueFixedBase(const std::string& urdfFile,
                             std::shared_ptr<core::Model> model,
                             const std::vector<double>& kp,
                             const std::vector<double>& kd,
                             const std::vector<std::string>& controlledJoints,
-                            const std::array<double, 3> gravity = g);
+                            const std::array<double, 3> gravity = g,
+                            const double massMatrixPeriod = 0.0,
+                            const double biasForcesPeriod = 0.0);
     ~ComputedTorqueFixedBase() override;
 
     bool initialize() override;
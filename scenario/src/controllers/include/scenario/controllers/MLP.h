@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef SCENARIO_CONTROLLERS_MLP_H
+#define SCENARIO_CONTROLLERS_MLP_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scenario::controllers {
+    class MLP;
+    enum class Activation
+    {
+        Linear = 0,
+        Tanh = 1,
+        ReLU = 2,
+        ELU = 3,
+    };
+} // namespace scenario::controllers
+
+// Feed-forward network of dense layers evaluated in single precision.
+//
+// The weights file is a little-endian binary file with the following layout:
+//
+//   char[4]  magic "SMLP"
+//   uint32   version (1)
+//   uint32   number of layers
+//   for each layer:
+//     uint32   inputs
+//     uint32   outputs
+//     uint32   activation (see scenario::controllers::Activation)
+//     float32  weights[outputs][inputs] (row-major)
+//     float32  bias[outputs]
+//
+// The gym_ignition.context.gazebo.controllers.MLPPolicy class provides a
+// writer of this format from NumPy arrays.
+class scenario::controllers::MLP
+{
+public:
+    MLP();
+    ~MLP();
+
+    bool load(const std::string& weightsFile);
+
+    // The weights are passed row-major with shape (outputs, inputs)
+    bool addLayer(const size_t inputs,
+                  const size_t outputs,
+                  const std::vector<float>& weights,
+                  const std::vector<float>& bias,
+                  const Activation activation = Activation::Linear);
+
+    size_t inputSize() const;
+    size_t outputSize() const;
+    size_t numberOfLayers() const;
+
+    // The output is resized only if its size does not match
+    bool evaluate(const std::vector<float>& input, std::vector<float>& output);
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+#endif // SCENARIO_CONTROLLERS_MLP_H
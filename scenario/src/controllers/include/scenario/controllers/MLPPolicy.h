@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef SCENARIO_CONTROLLERS_MLPPOLICY_H
+#define SCENARIO_CONTROLLERS_MLPPOLICY_H
+
+#include "scenario/controllers/Controller.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace scenario::core {
+    class Model;
+} // namespace scenario::core
+
+namespace scenario::controllers {
+    class MLPPolicy;
+} // namespace scenario::controllers
+
+// Controller that evaluates a feed-forward policy in the simulation loop.
+//
+// The observation is the vector [s, ds] of the controlled joints, optionally
+// followed by the base orientation (wxyz) and the base linear and angular
+// velocities expressed in the base frame. It is normalized as
+// (observation - observationOffset) * observationScale before the network.
+// The output of the network is mapped to the action as
+// actionOffset + actionScale * output, and it is applied either as joint
+// torques or as joint position targets. Empty normalization vectors are
+// the identity.
+//
+// The observation is read once per controller period by updateStateFromModel,
+// and the network is evaluated by the following step. The torques are actuated
+// at every physics step in between, while the position targets are set only
+// when a new action is computed.
+class scenario::controllers::MLPPolicy final
+    : public scenario::controllers::Controller
+    , public scenario::controllers::UseScenarioModel
+{
+public:
+    enum class Output
+    {
+        Torque,
+        Position,
+    };
+
+    MLPPolicy() = delete;
+    MLPPolicy(const std::string& weightsFile,
+              std::shared_ptr<core::Model> model,
+              const std::vector<std::string>& controlledJoints,
+              const Output output = Output::Torque,
+              const bool baseObservation = false,
+              const std::vector<double>& observationOffset = {},
+              const std::vector<double>& observationScale = {},
+              const std::vector<double>& actionOffset = {},
+              const std::vector<double>& actionScale = {});
+    ~MLPPolicy() override;
+
+    bool initialize() override;
+    bool step(const StepSize& dt) override;
+    bool terminate() override;
+
+    bool updateStateFromModel() override;
+
+    const std::vector<std::string>& controlledJoints() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+#endif // SCENARIO_CONTROLLERS_MLPPOLICY_H
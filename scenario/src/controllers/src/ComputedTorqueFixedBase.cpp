@@ -22,6 +22,7 @@
 #include <iDynTree/ModelIO/ModelLoader.h>
 
 #include <cassert>
+#include <limits>
 #include <unordered_map>
 
 using namespace scenario::controllers;
@@ -41,6 +42,23 @@ public:
         std::unordered_map<std::string, core::JointControlMode> controlMode;
     } initialValues;
 
+    // Recomputation periods and ages of the cached dynamics quantities
+    struct CachedQuantity
+    {
+        double period = 0.0;
+        double age = std::numeric_limits<double>::infinity();
+
+        bool expired() const
+        {
+            // Tolerate the round-off of the accumulated step sizes
+            constexpr double Tolerance = 1e-9;
+            return age + Tolerance >= period;
+        }
+    };
+
+    CachedQuantity massMatrixCache;
+    CachedQuantity biasForcesCache;
+
     JointReferences jointReferences;
     std::unique_ptr<Buffers> buffers;
     std::unique_ptr<iDynTree::KinDynComputations> kinDyn;
@@ -59,6 +77,7 @@ public:
         jointPositions.resize(controlledDofs);
         jointVelocities.resize(controlledDofs);
         massMatrix.resize(controlledDofs + 6, controlledDofs + 6);
+        jointMassMatrix = Eigen::MatrixXd::Zero(controlledDofs, controlledDofs);
 
         kp = Eigen::ArrayXd(controlledDofs);
         kd = Eigen::ArrayXd(controlledDofs);
@@ -77,6 +96,9 @@ public:
     iDynTree::VectorDynSize jointVelocities;
     iDynTree::FreeFloatingGeneralizedTorques biasForces;
 
+    // Contiguous copy of the joint block of the cached mass matrix
+    Eigen::MatrixXd jointMassMatrix;
+
     Eigen::ArrayXd kp;
     Eigen::ArrayXd kd;
 
@@ -94,7 +116,9 @@ ComputedTorqueFixedBase::ComputedTorqueFixedBase(
     const std::vector<double>& kp,
     const std::vector<double>& kd,
     const std::vector<std::string>& controlledJoints,
-    const std::array<double, 3> gravity)
+    const std::array<double, 3> gravity,
+    const double massMatrixPeriod,
+    const double biasForcesPeriod)
     : Controller()
     , UseScenarioModel()
     , SetJointReferences()
@@ -114,6 +138,9 @@ ComputedTorqueFixedBase::ComputedTorqueFixedBase(
 
     pImpl->initialValues.gravity = gravity;
 
+    pImpl->massMatrixCache.period = massMatrixPeriod;
+    pImpl->biasForcesCache.period = biasForcesPeriod;
+
     pImpl->initialValues.kp = kp;
     pImpl->initialValues.kd = kd;
     assert(m_controlledJoints.size() == kp.size());
@@ -157,6 +184,13 @@ bool ComputedTorqueFixedBase::initialize()
         }
     }
 
+    if (pImpl->massMatrixCache.period < 0
+        || pImpl->biasForcesCache.period < 0) {
+        sError << "The recomputation periods of the mass matrix and the bias "
+               << "forces must be non-negative" << std::endl;
+        return false;
+    }
+
     iDynTree::ModelLoader loader;
     if (!loader.loadReducedModelFromFile(pImpl->urdfFile, m_controlledJoints)) {
         sError << "Failed to load reduced model from the urdf file"
@@ -199,10 +233,14 @@ bool ComputedTorqueFixedBase::initialize()
     pImpl->buffers->gravity[1] = pImpl->initialValues.gravity[1];
     pImpl->buffers->gravity[2] = pImpl->initialValues.gravity[2];
 
+    // Compute the dynamics quantities at the first update
+    pImpl->massMatrixCache.age = std::numeric_limits<double>::infinity();
+    pImpl->biasForcesCache.age = std::numeric_limits<double>::infinity();
+
     return true;
 }
 
-bool ComputedTorqueFixedBase::step(const Controller::StepSize& /*dt*/)
+bool ComputedTorqueFixedBase::step(const Controller::StepSize& dt)
 {
     // ===================
     // Intermediate Values
@@ -210,10 +248,8 @@ bool ComputedTorqueFixedBase::step(const Controller::StepSize& /*dt*/)
 
     const auto nrControlledDofs = pImpl->buffers->jointPositions.size();
 
-    auto Mfloating = iDynTree::toEigen(pImpl->buffers->massMatrix);
-
+    const auto& M = pImpl->buffers->jointMassMatrix;
     auto h = iDynTree::toEigen(pImpl->buffers->biasForces.jointTorques());
-    auto M = Mfloating.bottomRightCorner(nrControlledDofs, nrControlledDofs);
     assert(h.size() == nrControlledDofs);
     assert(M.size() == nrControlledDofs * nrControlledDofs);
 
@@ -267,6 +303,10 @@ bool ComputedTorqueFixedBase::step(const Controller::StepSize& /*dt*/)
         return false;
     }
 
+    // Age the cached dynamics quantities
+    pImpl->massMatrixCache.age += dt.count();
+    pImpl->biasForcesCache.age += dt.count();
+
     return true;
 }
 
@@ -309,6 +349,15 @@ bool ComputedTorqueFixedBase::updateStateFromModel()
         pImpl->buffers->jointVelocities.setVal(i, joint->velocity());
     }
 
+    const bool updateMassMatrix = pImpl->massMatrixCache.expired();
+    const bool updateBiasForces = pImpl->biasForcesCache.expired();
+
+    // Between the updates, the control law uses the cached quantities and
+    // only the joint state is needed
+    if (!(updateMassMatrix || updateBiasForces)) {
+        return true;
+    }
+
     if (!pImpl->kinDyn->setRobotState(pImpl->buffers->jointPositions,
                                       pImpl->buffers->jointVelocities,
                                       pImpl->buffers->gravity)) {
@@ -316,14 +365,28 @@ bool ComputedTorqueFixedBase::updateStateFromModel()
         return false;
     }
 
-    if (!pImpl->kinDyn->getFreeFloatingMassMatrix(pImpl->buffers->massMatrix)) {
-        sError << "Failed to get the mass matrix" << std::endl;
-        return false;
+    if (updateMassMatrix) {
+        if (!pImpl->kinDyn->getFreeFloatingMassMatrix(
+                pImpl->buffers->massMatrix)) {
+            sError << "Failed to get the mass matrix" << std::endl;
+            return false;
+        }
+
+        const auto nrControlledDofs = m_controlledJoints.size();
+        pImpl->buffers->jointMassMatrix =
+            iDynTree::toEigen(pImpl->buffers->massMatrix)
+                .bottomRightCorner(nrControlledDofs, nrControlledDofs);
+
+        pImpl->massMatrixCache.age = 0.0;
     }
 
-    if (!pImpl->kinDyn->generalizedBiasForces(pImpl->buffers->biasForces)) {
-        sError << "Failed to get the bias forces " << std::endl;
-        return false;
+    if (updateBiasForces) {
+        if (!pImpl->kinDyn->generalizedBiasForces(pImpl->buffers->biasForces)) {
+            sError << "Failed to get the bias forces " << std::endl;
+            return false;
+        }
+
+        pImpl->biasForcesCache.age = 0.0;
     }
 
     return true;
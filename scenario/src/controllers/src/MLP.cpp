@@ -0,0 +1,321 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "scenario/controllers/MLP.h"
+#include "scenario/core/utils/Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+using namespace scenario::controllers;
+
+class MLP::Impl
+{
+public:
+    // Number of outputs computed together by the kernel. The accumulators of
+    // a block fit in the vector registers, and the input is read once per
+    // block from the L1 cache.
+    static constexpr size_t BlockSize = 16;
+
+    struct Layer
+    {
+        size_t inputs = 0;
+        size_t outputs = 0;
+        size_t blocks = 0;
+        Activation activation = Activation::Linear;
+
+        // Weights packed as [block][input][BlockSize] and bias padded to a
+        // multiple of BlockSize. The padded outputs are always zero.
+        std::vector<float> weights;
+        std::vector<float> bias;
+    };
+
+    std::vector<Layer> layers;
+
+    // Ping-pong buffers of the layer outputs
+    std::vector<float> bufferA;
+    std::vector<float> bufferB;
+
+    static void dense(const Layer& layer, const float* input, float* output);
+    static void activate(const Activation activation, float* data, size_t n);
+};
+
+MLP::MLP()
+    : pImpl{std::make_unique<Impl>()}
+{}
+
+MLP::~MLP() = default;
+
+bool MLP::load(const std::string& weightsFile)
+{
+    std::ifstream file(weightsFile, std::ios::binary);
+
+    if (!file) {
+        sError << "Failed to open weights file '" << weightsFile << "'"
+               << std::endl;
+        return false;
+    }
+
+    // The size of the file bounds the size of the layers read from it
+    file.seekg(0, std::ios::end);
+    const auto fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0, std::ios::beg);
+
+    auto readUInt32 = [&file]() -> uint32_t {
+        uint32_t value = 0;
+        file.read(reinterpret_cast<char*>(&value), sizeof(value));
+        return value;
+    };
+
+    char magic[4] = {};
+    file.read(magic, sizeof(magic));
+
+    if (!file || std::memcmp(magic, "SMLP", sizeof(magic)) != 0) {
+        sError << "File '" << weightsFile << "' is not a valid weights file"
+               << std::endl;
+        return false;
+    }
+
+    const uint32_t version = readUInt32();
+
+    if (version != 1) {
+        sError << "Version " << version << " of the weights file is not "
+               << "supported" << std::endl;
+        return false;
+    }
+
+    const uint32_t numberOfLayers = readUInt32();
+    pImpl->layers.clear();
+
+    for (uint32_t l = 0; l < numberOfLayers; ++l) {
+        const uint32_t inputs = readUInt32();
+        const uint32_t outputs = readUInt32();
+        const uint32_t activation = readUInt32();
+
+        if (!file || activation > uint32_t(Activation::ELU)) {
+            sError << "Failed to read the header of layer " << l << std::endl;
+            pImpl->layers.clear();
+            return false;
+        }
+
+        if (inputs == 0 || outputs == 0) {
+            sError << "Layer " << l << " has no inputs or no outputs"
+                   << std::endl;
+            pImpl->layers.clear();
+            return false;
+        }
+
+        // The layer stores (inputs + 1) * outputs floats, including the bias
+        const uint64_t remaining =
+            fileSize - static_cast<uint64_t>(file.tellg());
+
+        if (uint64_t(inputs) + 1 > remaining / sizeof(float) / outputs) {
+            sError << "The size of layer " << l << " exceeds the size of the "
+                   << "weights file" << std::endl;
+            pImpl->layers.clear();
+            return false;
+        }
+
+        std::vector<float> weights(size_t(inputs) * outputs);
+        std::vector<float> bias(outputs);
+
+        file.read(reinterpret_cast<char*>(weights.data()),
+                  std::streamsize(weights.size() * sizeof(float)));
+        file.read(reinterpret_cast<char*>(bias.data()),
+                  std::streamsize(bias.size() * sizeof(float)));
+
+        if (!file) {
+            sError << "Failed to read the parameters of layer " << l
+                   << std::endl;
+            pImpl->layers.clear();
+            return false;
+        }
+
+        if (!this->addLayer(inputs,
+                            outputs,
+                            weights,
+                            bias,
+                            static_cast<Activation>(activation))) {
+            pImpl->layers.clear();
+            return false;
+        }
+    }
+
+    if (pImpl->layers.empty()) {
+        sError << "The weights file does not contain any layer" << std::endl;
+        return false;
+    }
+
+    if (file.peek() != std::ifstream::traits_type::eof()) {
+        sError << "The weights file has unexpected data after the last layer"
+               << std::endl;
+        pImpl->layers.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool MLP::addLayer(const size_t inputs,
+                   const size_t outputs,
+                   const std::vector<float>& weights,
+                   const std::vector<float>& bias,
+                   const Activation activation)
+{
+    if (inputs == 0 || outputs == 0) {
+        sError << "Layers must have at least one input and one output"
+               << std::endl;
+        return false;
+    }
+
+    if (weights.size() != inputs * outputs || bias.size() != outputs) {
+        sError << "The size of the weights or the bias does not match the "
+               << "size of the layer" << std::endl;
+        return false;
+    }
+
+    if (!pImpl->layers.empty() && pImpl->layers.back().outputs != inputs) {
+        sError << "The layer has " << inputs << " inputs but the previous "
+               << "layer has " << pImpl->layers.back().outputs << " outputs"
+               << std::endl;
+        return false;
+    }
+
+    constexpr size_t B = Impl::BlockSize;
+
+    Impl::Layer layer;
+    layer.inputs = inputs;
+    layer.outputs = outputs;
+    layer.blocks = (outputs + B - 1) / B;
+    layer.activation = activation;
+    layer.weights.assign(layer.blocks * inputs * B, 0.0f);
+    layer.bias.assign(layer.blocks * B, 0.0f);
+
+    // Pack the row-major weights in blocks of outputs
+    for (size_t row = 0; row < outputs; ++row) {
+        const size_t block = row / B;
+        const size_t lane = row % B;
+
+        for (size_t col = 0; col < inputs; ++col) {
+            layer.weights[(block * inputs + col) * B + lane] =
+                weights[row * inputs + col];
+        }
+    }
+
+    std::copy(bias.begin(), bias.end(), layer.bias.begin());
+
+    // The buffers hold the widest layer, including the padding
+    const size_t width = layer.blocks * B;
+    pImpl->bufferA.resize(std::max(pImpl->bufferA.size(), width));
+    pImpl->bufferB.resize(std::max(pImpl->bufferB.size(), width));
+
+    pImpl->layers.push_back(std::move(layer));
+    return true;
+}
+
+size_t MLP::inputSize() const
+{
+    return pImpl->layers.empty() ? 0 : pImpl->layers.front().inputs;
+}
+
+size_t MLP::outputSize() const
+{
+    return pImpl->layers.empty() ? 0 : pImpl->layers.back().outputs;
+}
+
+size_t MLP::numberOfLayers() const
+{
+    return pImpl->layers.size();
+}
+
+bool MLP::evaluate(const std::vector<float>& input, std::vector<float>& output)
+{
+    if (pImpl->layers.empty()) {
+        sError << "The network does not have any layer" << std::endl;
+        return false;
+    }
+
+    if (input.size() != this->inputSize()) {
+        sError << "The input has size " << input.size() << " but the network "
+               << "expects " << this->inputSize() << std::endl;
+        return false;
+    }
+
+    const float* in = input.data();
+    float* out = pImpl->bufferA.data();
+    float* next = pImpl->bufferB.data();
+
+    for (const auto& layer : pImpl->layers) {
+        Impl::dense(layer, in, out);
+        Impl::activate(layer.activation, out, layer.blocks * Impl::BlockSize);
+
+        in = out;
+        std::swap(out, next);
+    }
+
+    output.resize(this->outputSize());
+    std::copy(in, in + output.size(), output.begin());
+
+    return true;
+}
+
+void MLP::Impl::dense(const Layer& layer, const float* input, float* output)
+{
+    assert(layer.weights.size() == layer.blocks * layer.inputs * BlockSize);
+
+    const size_t inputs = layer.inputs;
+
+    // Each block is an axpy over the inputs: acc += W[:, j] * x[j].
+    // The inner loop has a fixed trip count and no reductions, therefore it
+    // is vectorized without reassociating the floating point sums.
+    for (size_t b = 0; b < layer.blocks; ++b) {
+        const float* w = layer.weights.data() + b * inputs * BlockSize;
+        const float* bias = layer.bias.data() + b * BlockSize;
+
+        float acc[BlockSize];
+        std::copy(bias, bias + BlockSize, acc);
+
+        for (size_t j = 0; j < inputs; ++j) {
+            const float x = input[j];
+            const float* wj = w + j * BlockSize;
+
+            for (size_t k = 0; k < BlockSize; ++k) {
+                acc[k] += wj[k] * x;
+            }
+        }
+
+        std::copy(acc, acc + BlockSize, output + b * BlockSize);
+    }
+}
+
+void MLP::Impl::activate(const Activation activation, float* data, size_t n)
+{
+    switch (activation) {
+        case Activation::Linear:
+            break;
+        case Activation::Tanh:
+            for (size_t i = 0; i < n; ++i) {
+                data[i] = std::tanh(data[i]);
+            }
+            break;
+        case Activation::ReLU:
+            for (size_t i = 0; i < n; ++i) {
+                data[i] = std::max(data[i], 0.0f);
+            }
+            break;
+        case Activation::ELU:
+            for (size_t i = 0; i < n; ++i) {
+                data[i] = data[i] > 0.0f ? data[i] : std::expm1(data[i]);
+            }
+            break;
+    }
+}
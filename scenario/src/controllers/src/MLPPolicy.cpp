@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "scenario/controllers/MLPPolicy.h"
+#include "scenario/controllers/MLP.h"
+#include "scenario/core/Joint.h"
+#include "scenario/core/Model.h"
+#include "scenario/core/utils/Log.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+using namespace scenario::controllers;
+
+class MLPPolicy::Impl
+{
+public:
+    std::string weightsFile;
+    std::vector<std::string> controlledJoints;
+
+    Output output = Output::Torque;
+    bool baseObservation = false;
+
+    std::vector<double> observationOffset;
+    std::vector<double> observationScale;
+    std::vector<double> actionOffset;
+    std::vector<double> actionScale;
+
+    std::unordered_map<std::string, core::JointControlMode> initialControlMode;
+
+    std::unique_ptr<MLP> network;
+
+    // Buffers
+    std::vector<double> observation;
+    std::vector<float> networkInput;
+    std::vector<float> networkOutput;
+    std::vector<double> action;
+
+    // Whether the observation was updated after the last evaluation
+    bool newObservation = false;
+
+    size_t observationSize() const
+    {
+        // Joint positions and velocities, base orientation and velocities
+        return 2 * controlledJoints.size() + (baseObservation ? 10 : 0);
+    }
+
+    static bool validNormalization(const std::vector<double>& vector,
+                                   const size_t size,
+                                   const std::string& name)
+    {
+        if (!vector.empty() && vector.size() != size) {
+            sError << "The " << name << " has size " << vector.size()
+                   << " instead of " << size << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+};
+
+MLPPolicy::MLPPolicy(const std::string& weightsFile,
+                     std::shared_ptr<core::Model> model,
+                     const std::vector<std::string>& controlledJoints,
+                     const Output output,
+                     const bool baseObservation,
+                     const std::vector<double>& observationOffset,
+                     const std::vector<double>& observationScale,
+                     const std::vector<double>& actionOffset,
+                     const std::vector<double>& actionScale)
+    : Controller()
+    , UseScenarioModel()
+    , pImpl{std::make_unique<Impl>()}
+{
+    m_model = model;
+    pImpl->weightsFile = weightsFile;
+    pImpl->controlledJoints = controlledJoints;
+
+    if (pImpl->controlledJoints.empty()) {
+        sDebug << "No list of controlled joints found. "
+               << "Controlling all the robots joints." << std::endl;
+        pImpl->controlledJoints = m_model->jointNames();
+    }
+
+    pImpl->output = output;
+    pImpl->baseObservation = baseObservation;
+
+    pImpl->observationOffset = observationOffset;
+    pImpl->observationScale = observationScale;
+    pImpl->actionOffset = actionOffset;
+    pImpl->actionScale = actionScale;
+}
+
+MLPPolicy::~MLPPolicy() = default;
+
+bool MLPPolicy::initialize()
+{
+    sDebug << "Initializing MLPPolicy" << std::endl;
+
+    if (pImpl->network) {
+        sWarning << "The policy has been already initialized" << std::endl;
+        return true;
+    }
+
+    if (!(m_model && m_model->valid())) {
+        sError << "Couldn't initialize controller. Model not valid."
+               << std::endl;
+        return false;
+    }
+
+    if (pImpl->controlledJoints.empty()) {
+        sError << "The list of controlled joints is not valid" << std::endl;
+        return false;
+    }
+
+    for (auto& joint : m_model->joints(pImpl->controlledJoints)) {
+        if (joint->dofs() != 1) {
+            sError << "Joint '" << joint->name()
+                   << "' does not have 1 DoF and is not supported" << std::endl;
+            return false;
+        }
+    }
+
+    auto network = std::make_unique<MLP>();
+
+    if (!network->load(pImpl->weightsFile)) {
+        sError << "Failed to load the policy from '" << pImpl->weightsFile
+               << "'" << std::endl;
+        return false;
+    }
+
+    const size_t observationSize = pImpl->observationSize();
+    const size_t actionSize = pImpl->controlledJoints.size();
+
+    if (network->inputSize() != observationSize) {
+        sError << "The policy has " << network->inputSize()
+               << " inputs but the observation has size " << observationSize
+               << std::endl;
+        return false;
+    }
+
+    if (network->outputSize() != actionSize) {
+        sError << "The policy has " << network->outputSize()
+               << " outputs but " << actionSize << " joints are controlled"
+               << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    ok = ok
+         && Impl::validNormalization(
+             pImpl->observationOffset, observationSize, "observation offset");
+    ok = ok
+         && Impl::validNormalization(
+             pImpl->observationScale, observationSize, "observation scale");
+    ok = ok
+         && Impl::validNormalization(
+             pImpl->actionOffset, actionSize, "action offset");
+    ok = ok
+         && Impl::validNormalization(
+             pImpl->actionScale, actionSize, "action scale");
+
+    if (!ok) {
+        return false;
+    }
+
+    const auto controlMode = pImpl->output == Output::Torque
+                                 ? core::JointControlMode::Force
+                                 : core::JointControlMode::Position;
+
+    for (auto& joint : m_model->joints(pImpl->controlledJoints)) {
+        pImpl->initialControlMode[joint->name()] = joint->controlMode();
+
+        if (!joint->setControlMode(controlMode)) {
+            sError << "Failed to set the control mode of joint '"
+                   << joint->name() << "'" << std::endl;
+            return false;
+        }
+    }
+
+    // Initialize buffers
+    pImpl->observation.resize(observationSize);
+    pImpl->networkInput.resize(observationSize);
+    pImpl->networkOutput.resize(actionSize);
+    pImpl->action.assign(actionSize, 0.0);
+    pImpl->newObservation = false;
+
+    pImpl->network = std::move(network);
+    return true;
+}
+
+bool MLPPolicy::step(const StepSize& /*dt*/)
+{
+    assert(pImpl->network);
+
+    const auto& joints = pImpl->controlledJoints;
+    const bool newAction = pImpl->newObservation;
+
+    // ======
+    // Policy
+    // ======
+
+    if (newAction) {
+        pImpl->newObservation = false;
+
+        if (!pImpl->network->evaluate(pImpl->networkInput,
+                                      pImpl->networkOutput)) {
+            sError << "Failed to evaluate the policy" << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < pImpl->action.size(); ++i) {
+            double value = pImpl->networkOutput[i];
+
+            if (!pImpl->actionScale.empty()) {
+                value *= pImpl->actionScale[i];
+            }
+
+            if (!pImpl->actionOffset.empty()) {
+                value += pImpl->actionOffset[i];
+            }
+
+            pImpl->action[i] = value;
+        }
+    }
+
+    // =========
+    // Actuation
+    // =========
+
+    switch (pImpl->output) {
+        case Output::Torque:
+            // Force targets are consumed by the physics at every step
+            if (!m_model->setJointGeneralizedForceTargets(pImpl->action,
+                                                          joints)) {
+                sError << "Failed to set joint forces" << std::endl;
+                return false;
+            }
+            break;
+        case Output::Position:
+            // Position targets are held by the joint controller
+            if (newAction
+                && !m_model->setJointPositionTargets(pImpl->action, joints)) {
+                sError << "Failed to set joint position targets" << std::endl;
+                return false;
+            }
+            break;
+    }
+
+    return true;
+}
+
+bool MLPPolicy::terminate()
+{
+    bool ok = true;
+
+    for (const auto& [jointName, controlMode] : pImpl->initialControlMode) {
+
+        auto joint = m_model->getJoint(jointName);
+
+        if (!joint->setControlMode(controlMode)) {
+            sError << "Failed to restore original control mode of joint '"
+                   << jointName << "'" << std::endl;
+            ok = ok && false;
+        }
+    }
+
+    pImpl->network.reset();
+    return ok;
+}
+
+bool MLPPolicy::updateStateFromModel()
+{
+    assert(pImpl->network);
+
+    // ===========
+    // Observation
+    // ===========
+
+    const auto& joints = pImpl->controlledJoints;
+    auto& observation = pImpl->observation;
+    auto it = observation.begin();
+
+    const auto s = m_model->jointPositions(joints);
+    const auto ds = m_model->jointVelocities(joints);
+    it = std::copy(s.begin(), s.end(), it);
+    it = std::copy(ds.begin(), ds.end(), it);
+
+    if (pImpl->baseObservation) {
+        const auto orientation = m_model->baseOrientation();
+        const auto linearVelocity = m_model->baseBodyLinearVelocity();
+        const auto angularVelocity = m_model->baseBodyAngularVelocity();
+        it = std::copy(orientation.begin(), orientation.end(), it);
+        it = std::copy(linearVelocity.begin(), linearVelocity.end(), it);
+        it = std::copy(angularVelocity.begin(), angularVelocity.end(), it);
+    }
+
+    assert(it == observation.end());
+
+    for (size_t i = 0; i < observation.size(); ++i) {
+        double value = observation[i];
+
+        if (!pImpl->observationOffset.empty()) {
+            value -= pImpl->observationOffset[i];
+        }
+
+        if (!pImpl->observationScale.empty()) {
+            value *= pImpl->observationScale[i];
+        }
+
+        pImpl->networkInput[i] = static_cast<float>(value);
+    }
+
+    pImpl->newObservation = true;
+    return true;
+}
+
+const std::vector<std::string>& MLPPolicy::controlledJoints() const
+{
+    return pImpl->controlledJoints;
+}
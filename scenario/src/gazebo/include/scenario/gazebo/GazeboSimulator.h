@@ -171,6 +171,37 @@ public:
     bool insertWorldsFromSDF(const std::string& worldFile,
                              const std::vector<std::string>& worldNames = {});
 
+    /**
+     * Step the worlds of the simulator in parallel.
+     *
+     * When enabled, each world is simulated by its own server and every
+     * simulator run dispatches the steps of the worlds to a pool of worker
+     * threads, returning when all of them completed. Worlds do not share any
+     * state, therefore their evolution does not depend on the number of
+     * threads nor on the scheduling.
+     *
+     * @note This function can only be used while the simulator object is
+     * uninitialized. It has no effect on simulators with a single world.
+     *
+     * @param numOfThreads The number of worker threads. If zero, the number of
+     * concurrent threads supported by the hardware is used.
+     * @return True for success, false otherwise.
+     *
+     * @note Collision detectors that rely on global state cannot be stepped
+     * concurrently. Worlds that do not select a collision detector use
+     * bullet instead of the ODE default of DART, and the initialization
+     * fails if a world selects ODE.
+     */
+    bool enableParallelStepping(const size_t numOfThreads = 0);
+
+    /**
+     * Get the number of worker threads used to step the worlds.
+     *
+     * @return The number of worker threads if parallel stepping is enabled,
+     * zero otherwise.
+     */
+    size_t parallelSteppingThreads() const;
+
     /**
      * Get the list if the world names part of the simulation.
      *
@@ -40,6 +40,20 @@
 
 namespace scenario::gazebo {
     class Joint;
+    /// The joint signals whose history can be recorded.
+    enum class JointSignal
+    {
+        /// The generalized force commanded to the joint.
+        AppliedForce,
+        /// The joint position.
+        Position,
+        /// The joint velocity.
+        Velocity,
+        /// The position target of the joint controller.
+        PositionTarget,
+        /// The velocity target of the joint controller.
+        VelocityTarget,
+    };
 } // namespace scenario::gazebo
 
 class scenario::gazebo::Joint final
@@ -143,6 +157,44 @@ public:
     bool resetJoint(const std::vector<double>& position,
                     const std::vector<double>& velocity);
 
+    /**
+     * Check if the history of a joint signal is enabled.
+     *
+     * @param signal The joint signal.
+     * @return True if the history is enabled, false otherwise.
+     */
+    bool historyEnabled(const JointSignal signal) const;
+
+    /**
+     * Enable the history of a joint signal.
+     *
+     * The history stores the values of the signal at every physics step in a
+     * fixed-size window. Changing the size of an enabled history keeps the
+     * most recent values.
+     *
+     * @param signal The joint signal.
+     * @param enable True to enable, false to disable.
+     * @param maxHistorySize The number of physics steps of the window.
+     * @return True for success, false otherwise.
+     */
+    bool enableHistory(const JointSignal signal,
+                       const bool enable = true,
+                       const size_t maxHistorySize = 100);
+
+    /**
+     * Get the history of a joint signal.
+     *
+     * The history is initialized with zeros and it contains #DoFs values for
+     * each physics step, from the oldest to the newest step. The applied
+     * force is recorded only in the steps in which the joint has a force
+     * command.
+     *
+     * @param signal The joint signal.
+     * @return The history of the signal if enabled, an empty vector
+     * otherwise.
+     */
+    std::vector<double> history(const JointSignal signal) const;
+
     /**
      * Set the Coulomb friction parameter of the joint.
      *
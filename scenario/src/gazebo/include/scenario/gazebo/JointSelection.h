@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This project is dual licensed under LGPL v2.1+ or Apache License.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SCENARIO_GAZEBO_JOINTSELECTION_H
+#define SCENARIO_GAZEBO_JOINTSELECTION_H
+
+#include "scenario/core/Joint.h"
+
+#include <ignition/gazebo/Entity.hh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace scenario::gazebo {
+    class JointSelection;
+    class Model;
+} // namespace scenario::gazebo
+
+/**
+ * Pre-resolved selection of joints of a model.
+ *
+ * A selection is created once from a list of joint names with
+ * ``Model::jointSelection`` and it can be passed to all the serialized
+ * getters and setters of the model in place of the joint names. It stores
+ * the resolved joints, their entities and the DoF offsets, so that the
+ * cost of the serialized methods scales only with the number of DoFs.
+ *
+ * @note A selection is bound to the model that created it.
+ */
+class scenario::gazebo::JointSelection
+{
+public:
+    /**
+     * Get the names of the selected joints.
+     *
+     * @return The names of the selected joints.
+     */
+    inline const std::vector<std::string>& jointNames() const
+    {
+        return m_jointNames;
+    }
+
+    /**
+     * Get the number of DoFs of the selection.
+     *
+     * @return The sum of the DoFs of the selected joints.
+     */
+    inline size_t dofs() const { return m_offsets.back(); }
+
+    /**
+     * Get the entity of the model that created the selection.
+     *
+     * @return The entity of the model.
+     */
+    inline ignition::gazebo::Entity modelEntity() const
+    {
+        return m_modelEntity;
+    }
+
+private:
+    friend class scenario::gazebo::Model;
+
+    JointSelection(const ignition::gazebo::Entity modelEntity)
+        : m_modelEntity(modelEntity)
+        , m_offsets({0})
+    {}
+
+    ignition::gazebo::Entity m_modelEntity;
+
+    std::vector<std::string> m_jointNames;
+    std::vector<core::JointPtr> m_joints;
+    std::vector<ignition::gazebo::Entity> m_entities;
+
+    // Offset of the first DoF of each joint (size: joints + 1)
+    std::vector<size_t> m_offsets;
+
+    // Index of each selected DoF in the joint state cache of the model.
+    // It is empty if the model has no cache.
+    std::vector<size_t> m_cacheIndices;
+};
+
+#endif // SCENARIO_GAZEBO_JOINTSELECTION_H
@@ -42,8 +42,31 @@
 
 namespace scenario::gazebo {
     class Link;
+    struct ContactStatistics;
 } // namespace scenario::gazebo
 
+/**
+ * Contact data of a link accumulated over the physics steps of the last run.
+ *
+ * The forces are the total contact forces applied to the link, expressed in
+ * world coordinates.
+ */
+struct scenario::gazebo::ContactStatistics
+{
+    /// The number of physics steps of the last run.
+    size_t steps = 0;
+    /// The number of physics steps in which the link was in contact.
+    size_t stepsInContact = 0;
+    /// The total number of contact points over all the steps.
+    size_t numOfContactPoints = 0;
+    /// The maximum norm of the contact force.
+    double maxForce = 0.0;
+    /// The contact force averaged over all the steps.
+    std::array<double, 3> meanForce = {0, 0, 0};
+    /// The impulse of the contact force over the run.
+    std::array<double, 3> impulse = {0, 0, 0};
+};
+
 class scenario::gazebo::Link final
     : public scenario::core::Link
     , public scenario::gazebo::GazeboEntity
@@ -185,6 +208,54 @@ public:
                                const std::array<double, 3>& torque,
                                const double duration = 0.0);
 
+    /**
+     * Restrict the contacts of the link to those with the given bodies.
+     *
+     * The contacts with all the other bodies are discarded by the physics
+     * system before being stored for the link. The filter has effect only if
+     * contact detection is enabled, and it is removed when contact detection
+     * gets disabled. The contact messages of other systems, like contact
+     * sensors, are not filtered.
+     *
+     * @param bodies The names of the models or the scoped names of the links
+     * (``model::link``) whose contacts have to be reported. An empty vector
+     * removes the filter and all the contacts are reported.
+     * @return True for success, false otherwise.
+     */
+    bool setContactFilter(const std::vector<std::string>& bodies);
+
+    /**
+     * Check if the accumulation of contacts is enabled.
+     *
+     * @return True if the accumulation of contacts is enabled, false
+     * otherwise.
+     */
+    bool contactAccumulationEnabled() const;
+
+    /**
+     * Enable the accumulation of contacts over the physics steps of a run.
+     *
+     * When multiple physics steps are executed by a single run, the contacts
+     * returned by ``Link::contacts`` refer only to the last step. The contact
+     * statistics, instead, aggregate the contacts of all the steps, including
+     * short impacts that ended before the last one. Enabling the accumulation
+     * also enables contact detection.
+     *
+     * @param enable True to enable the accumulation, false to disable.
+     * @return True for success, false otherwise.
+     */
+    bool enableContactAccumulation(const bool enable = true);
+
+    /**
+     * Get the contact data accumulated over the physics steps of the last
+     * run.
+     *
+     * @throw exceptions::LinkError if the accumulation of contacts is not
+     * enabled.
+     * @return The contact statistics of the link.
+     */
+    ContactStatistics contactStatistics() const;
+
 private:
     class Impl;
     std::unique_ptr<Impl> pImpl;
@@ -29,6 +29,7 @@
 
 #include "scenario/core/Model.h"
 #include "scenario/gazebo/GazeboEntity.h"
+#include "scenario/gazebo/JointSelection.h"
 
 #include <ignition/gazebo/Entity.hh>
 #include <ignition/gazebo/EntityComponentManager.hh>
@@ -41,8 +42,35 @@
 
 namespace scenario::gazebo {
     class Model;
+    struct ContactStatistics;
+    struct ControllerStatistics;
+    enum class JointSignal;
 } // namespace scenario::gazebo
 
+/**
+ * Execution times of the controller of a model.
+ *
+ * A step is a call of the controller by the ControllerRunner plugin,
+ * including the update of its references and state. The times are wall-clock
+ * durations in seconds.
+ */
+struct scenario::gazebo::ControllerStatistics
+{
+    /// The number of steps of the controller.
+    size_t steps = 0;
+    /// The number of steps that lasted longer than the controller period.
+    size_t overruns = 0;
+    /// The minimum duration of a step.
+    double minTime = 0.0;
+    /// The mean duration of a step.
+    double meanTime = 0.0;
+    /// The 99th percentile of the duration of a step, estimated with a
+    /// resolution of about 10%.
+    double p99Time = 0.0;
+    /// The maximum duration of a step.
+    double maxTime = 0.0;
+};
+
 class scenario::gazebo::Model final
     : public scenario::core::Model
     , public scenario::gazebo::GazeboEntity
@@ -182,6 +210,333 @@ public:
      */
     bool enableSelfCollisions(const bool enable = true);
 
+    /**
+     * Restrict the contacts of all the links to those with the given bodies.
+     *
+     * @param bodies The names of the models or the scoped names of the links
+     * (``model::link``) whose contacts have to be reported. An empty vector
+     * removes the filter and all the contacts are reported.
+     * @return True for success, false otherwise.
+     *
+     * @see Link::setContactFilter
+     */
+    bool setContactFilter(const std::vector<std::string>& bodies);
+
+    /**
+     * Enable the accumulation of contacts of all the links.
+     *
+     * @param enable True to enable the accumulation, false to disable.
+     * @return True for success, false otherwise.
+     *
+     * @see Link::enableContactAccumulation
+     */
+    bool enableContactAccumulation(const bool enable = true);
+
+    /**
+     * Get the contact data of the links accumulated over the physics steps of
+     * the last run.
+     *
+     * @param linkNames Optional vector of link names. If empty, all the links
+     * are considered, serialized as ``Model::linkNames``.
+     * @throw exceptions::LinkError if the accumulation of contacts of a link
+     * is not enabled.
+     * @return The contact statistics of the links.
+     */
+    std::vector<ContactStatistics> contactStatistics(
+        const std::vector<std::string>& linkNames = {}) const;
+
+    /**
+     * Get the execution times of the controller of the model.
+     *
+     * The statistics are collected by the ControllerRunner plugin since the
+     * first step of the controller. If the model has more than one
+     * ControllerRunner, they refer to the first one that was loaded.
+     *
+     * @throw exceptions::ModelError if the model has no controller.
+     * @return The statistics of the controller.
+     */
+    ControllerStatistics controllerStatistics() const;
+
+    /**
+     * Get a read-only view of the cached joint positions.
+     *
+     * The state of all the joints of the model, serialized as
+     * ``Model::jointNames``, is stored in contiguous buffers that are
+     * refreshed by the physics system once per simulation step. The buffers
+     * are allocated when the model is inserted and never reallocated. They
+     * belong to the ECM, therefore the returned pointer remains valid until
+     * the model is removed from the world, unless a reference to the buffers
+     * is held with ``Model::jointStateCacheOwner``.
+     *
+     * @return A pointer to ``Model::dofs`` contiguous joint positions, or
+     * ``nullptr`` if the cache is not available.
+     */
+    const double* jointPositionsView() const;
+
+    /**
+     * Get a read-only view of the cached joint velocities.
+     *
+     * @return A pointer to ``Model::dofs`` contiguous joint velocities, or
+     * ``nullptr`` if the cache is not available.
+     * @see jointPositionsView
+     */
+    const double* jointVelocitiesView() const;
+
+    /**
+     * Get a read-only view of the cached joint accelerations.
+     *
+     * @return A pointer to ``Model::dofs`` contiguous joint accelerations, or
+     * ``nullptr`` if the cache is not available.
+     * @see jointPositionsView
+     */
+    const double* jointAccelerationsView() const;
+
+    /**
+     * Get a read-only view of the cached joint generalized forces.
+     *
+     * @return A pointer to ``Model::dofs`` contiguous joint generalized
+     * forces, or ``nullptr`` if the cache is not available.
+     * @see jointPositionsView
+     */
+    const double* jointGeneralizedForcesView() const;
+
+    /**
+     * Get a shared owner of the buffers of the joint state cache.
+     *
+     * Holding the returned pointer keeps the buffers allocated also after the
+     * model is removed from the world. From then on, they store the last state
+     * refreshed by the physics system.
+     *
+     * @return The owner of the buffers returned by the view methods, or
+     * ``nullptr`` if the cache is not available.
+     */
+    std::shared_ptr<const void> jointStateCacheOwner() const;
+
+    /**
+     * Enable the history of a signal of the model joints.
+     *
+     * @param signal The joint signal.
+     * @param enable True to enable, false to disable.
+     * @param maxHistorySizePerJoint The number of physics steps of the window.
+     * @param jointNames Optional vector of considered joints. By default,
+     * ``Model::jointNames`` is used.
+     * @return True for success, false otherwise.
+     *
+     * @see Joint::enableHistory
+     */
+    bool enableHistory(const JointSignal signal,
+                       const bool enable = true,
+                       const size_t maxHistorySizePerJoint = 100,
+                       const std::vector<std::string>& jointNames = {});
+
+    /**
+     * Check if the history of a signal of the model joints is enabled.
+     *
+     * @param signal The joint signal.
+     * @param jointNames Optional vector of considered joints. By default,
+     * ``Model::jointNames`` is used.
+     * @return True if the history is enabled for all the joints, false
+     * otherwise.
+     */
+    bool historyEnabled(const JointSignal signal,
+                        const std::vector<std::string>& jointNames = {}) const;
+
+    /**
+     * Get the history of a signal of the model joints.
+     *
+     * The values of the joints are serialized for each physics step, from
+     * the oldest to the newest.
+     *
+     * @param signal The joint signal.
+     * @param jointNames Optional vector of considered joints. By default,
+     * ``Model::jointNames`` is used.
+     * @return The history of the signal.
+     */
+    std::vector<double>
+    history(const JointSignal signal,
+            const std::vector<std::string>& jointNames = {}) const;
+
+    /**
+     * Enable the recording of the joint trajectory at every physics step.
+     *
+     * When a run executes multiple physics steps, the joint state of the
+     * model only reflects the last one. The recording stores the joint
+     * positions, velocities and generalized forces, together with the model
+     * pose, of all the physics steps of the last unpaused run in a ring buffer
+     * that keeps the most recent ``capacity`` steps.
+     *
+     * @param enable True to enable the recording, false to disable.
+     * @param capacity The maximum number of recorded steps. It should not be
+     * smaller than the number of physics steps executed by a run.
+     * @return True for success, false otherwise.
+     */
+    bool enableTrajectoryRecording(const bool enable = true,
+                                   const size_t capacity = 1000);
+
+    /**
+     * Check if the recording of the joint trajectory is enabled.
+     *
+     * @return True if the recording is enabled, false otherwise.
+     */
+    bool trajectoryRecordingEnabled() const;
+
+    /**
+     * Get the number of physics steps recorded during the last run.
+     *
+     * @throw exceptions::ModelError if the recording is not enabled.
+     * @return The number of recorded steps.
+     */
+    size_t numOfRecordedSteps() const;
+
+    /**
+     * Get the simulated time of the recorded physics steps.
+     *
+     * @throw exceptions::ModelError if the recording is not enabled.
+     * @return The simulated time of each recorded step, in seconds, from the
+     * oldest to the newest.
+     */
+    std::vector<double> recordedTimes() const;
+
+    /**
+     * Get the recorded joint positions.
+     *
+     * @throw exceptions::ModelError if the recording is not enabled.
+     * @return The contiguous row-major (steps x DoFs) matrix of the joint
+     * positions, with the rows ordered from the oldest to the newest step and
+     * the columns serialized as ``Model::jointNames``.
+     */
+    std::vector<double> recordedJointPositions() const;
+
+    /**
+     * Get the recorded joint velocities.
+     *
+     * @throw exceptions::ModelError if the recording is not enabled.
+     * @return The contiguous row-major (steps x DoFs) matrix of the joint
+     * velocities.
+     * @see recordedJointPositions
+     */
+    std::vector<double> recordedJointVelocities() const;
+
+    /**
+     * Get the recorded joint generalized forces.
+     *
+     * @throw exceptions::ModelError if the recording is not enabled.
+     * @return The contiguous row-major (steps x DoFs) matrix of the joint
+     * generalized forces.
+     * @see recordedJointPositions
+     */
+    std::vector<double> recordedJointGeneralizedForces() const;
+
+    /**
+     * Get the recorded model poses.
+     *
+     * @throw exceptions::ModelError if the recording is not enabled.
+     * @return The contiguous row-major (steps x 7) matrix of the model poses.
+     * Each row contains the position and the wxyz quaternion of the model
+     * frame in world coordinates.
+     */
+    std::vector<double> recordedBasePoses() const;
+
+    /**
+     * Get the duration of the interpolation of the position targets.
+     *
+     * @return The duration in seconds. Zero means that the duration is the
+     * time elapsed since the previous change of the targets.
+     * @see setInterpolationDuration
+     */
+    double interpolationDuration() const;
+
+    /**
+     * Set the duration of the interpolation of the position targets.
+     *
+     * The joints controlled in PositionInterpolated move towards a new
+     * position target along a minimum jerk trajectory generated at the
+     * controller period. By default, the trajectory lasts the time elapsed
+     * since the previous change of the targets, so that targets set at a
+     * lower rate than the controller are tracked smoothly. The first target
+     * after enabling the control mode is reached within a controller period.
+     *
+     * @param duration The duration in seconds. Zero restores the default.
+     * @return True for success, false otherwise.
+     */
+    bool setInterpolationDuration(const double duration);
+
+    // ===============
+    // Joint Selection
+    // ===============
+
+    /**
+     * Create a pre-resolved selection of joints.
+     *
+     * The selection can be used in place of the vector of joint names in
+     * all the serialized getters and setters. Resolving the joints only once
+     * avoids the lookup of the names at every call.
+     *
+     * @param jointNames Optional vector of considered joints. By default,
+     * ``Model::jointNames`` is used.
+     * @throw exceptions::JointNotFound if one of the joints does not exist.
+     * @return The selection of the joints.
+     */
+    JointSelection
+    jointSelection(const std::vector<std::string>& jointNames = {}) const;
+
+    /**
+     * Reset the positions of the selected joints.
+     *
+     * @param positions The desired new joint positions.
+     * @param selection The selection of the considered joints.
+     * @return True for success, false otherwise.
+     */
+    bool resetJointPositions(const std::vector<double>& positions,
+                             const JointSelection& selection);
+
+    /**
+     * Reset the velocities of the selected joints.
+     *
+     * @param velocities The desired new joint velocities.
+     * @param selection The selection of the considered joints.
+     * @return True for success, false otherwise.
+     */
+    bool resetJointVelocities(const std::vector<double>& velocities,
+                              const JointSelection& selection);
+
+    // The following overloads are equivalent to the methods accepting the
+    // vector of joint names, refer to their documentation.
+
+    std::vector<double> jointPositions(const JointSelection& selection) const;
+
+    std::vector<double> jointVelocities(const JointSelection& selection) const;
+
+    std::vector<double>
+    jointAccelerations(const JointSelection& selection) const;
+
+    std::vector<double>
+    jointGeneralizedForces(const JointSelection& selection) const;
+
+    bool setJointPositionTargets(const std::vector<double>& positions,
+                                 const JointSelection& selection);
+
+    bool setJointVelocityTargets(const std::vector<double>& velocities,
+                                 const JointSelection& selection);
+
+    bool setJointAccelerationTargets(const std::vector<double>& accelerations,
+                                     const JointSelection& selection);
+
+    bool setJointGeneralizedForceTargets(const std::vector<double>& forces,
+                                         const JointSelection& selection);
+
+    std::vector<double>
+    jointPositionTargets(const JointSelection& selection) const;
+
+    std::vector<double>
+    jointVelocityTargets(const JointSelection& selection) const;
+
+    std::vector<double>
+    jointAccelerationTargets(const JointSelection& selection) const;
+
+    std::vector<double>
+    jointGeneralizedForceTargets(const JointSelection& selection) const;
+
     // ==========
     // Model Core
     // ==========
@@ -41,6 +41,7 @@
 
 namespace scenario::gazebo {
     class World;
+    struct ModelSpec;
 
     /**
      * Supported physics engines.
@@ -53,6 +54,23 @@ namespace scenario::gazebo {
     };
 } // namespace scenario::gazebo
 
+/**
+ * Description of a model to insert in the world.
+ */
+struct scenario::gazebo::ModelSpec
+{
+    /// Either the path to a URDF or SDF file, or a string containing the
+    /// URDF or SDF XML of the model.
+    std::string source;
+    /// True if the source is a XML string, false if it is a file path.
+    bool sourceIsString = false;
+    /// The initial pose of the model.
+    core::Pose pose = core::Pose::Identity();
+    /// The optional name of the model. If empty, the name specified in the
+    /// description is used.
+    std::string name;
+};
+
 class scenario::gazebo::World final
     : public scenario::core::World
     , public scenario::gazebo::GazeboEntity
@@ -98,10 +116,21 @@ public:
      * insert in the simulator a plugin with one of the supported physics
      * engines.
      *
+     * The physics engine can execute multiple steps in each simulator step,
+     * splitting the step size among them. The state stored in the simulator
+     * is updated only after the last sub-step, reducing the overhead of
+     * high-resolution physics. Joint and link commands are held for all the
+     * sub-steps, and the entity states refer to the last sub-step. Note that
+     * the simulator step size has to be set to ``substeps`` times the desired
+     * resolution of the physics engine.
+     *
      * @param engine The desired physics engine.
+     * @param substeps The number of physics engine steps in each simulator
+     * step.
      * @return True for success, false otherwise.
      */
-    bool setPhysicsEngine(const PhysicsEngine engine);
+    bool setPhysicsEngine(const PhysicsEngine engine,
+                          const size_t substeps = 1);
 
     /**
      * Set the gravity of the world.
@@ -174,6 +203,23 @@ public:
                                const core::Pose& pose = core::Pose::Identity(),
                                const std::string& overrideModelName = {});
 
+    /**
+     * Insert multiple models into the world.
+     *
+     * The sources shared by multiple models are loaded and converted only
+     * once. The sources and the names of all the models are checked before
+     * inserting any of them, then all the entities are created and their
+     * resources are initialized. If the insertion fails, none of the models
+     * is inserted.
+     *
+     * @param models The descriptions of the models to insert.
+     * @return True for success, false otherwise.
+     *
+     * @warning In order to process the model insertion, a simulator step must
+     * be executed. It could either be a paused or unpaused step.
+     */
+    bool insertModels(const std::vector<ModelSpec>& models);
+
     /**
      * Remove a model from the world.
      *
@@ -185,6 +231,43 @@ public:
      */
     bool removeModel(const std::string& modelName);
 
+    /**
+     * Save the state of the world in memory.
+     *
+     * The state contains, for all the models of the world, the base pose and
+     * velocity, the joint positions and velocities, the joint control modes,
+     * targets and PIDs (including their integrators), and the queues of link
+     * wrenches applied for a given duration.
+     *
+     * @return The handle of the saved state.
+     */
+    uint64_t saveState();
+
+    /**
+     * Restore a state of the world saved in memory.
+     *
+     * The components of the models are updated instantaneously, and the
+     * physics engine is aligned during the next simulator step, that could
+     * either be a paused or unpaused step. The SDF of the models is not
+     * processed again.
+     *
+     * @param handle The handle returned by ``World::saveState``.
+     * @return True for success, false otherwise.
+     *
+     * @note The simulated time is not restored. Models inserted after saving
+     * the state are not affected, and the restore fails if any of the models
+     * of the saved state has been removed.
+     */
+    bool restoreState(const uint64_t handle);
+
+    /**
+     * Delete a state of the world saved in memory.
+     *
+     * @param handle The handle returned by ``World::saveState``.
+     * @return True for success, false otherwise.
+     */
+    bool removeState(const uint64_t handle);
+
     // ==========
     // World Core
     // ==========
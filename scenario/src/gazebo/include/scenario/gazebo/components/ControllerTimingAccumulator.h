@@ -24,8 +24,8 @@
  * limitations under the License.
  */
 
-#ifndef IGNITION_GAZEBO_COMPONENTS_HISTORYOFAPPLIEDJOINTFORCES_H
-#define IGNITION_GAZEBO_COMPONENTS_HISTORYOFAPPLIEDJOINTFORCES_H
+#ifndef IGNITION_GAZEBO_COMPONENTS_CONTROLLERTIMINGACCUMULATOR_H
+#define IGNITION_GAZEBO_COMPONENTS_CONTROLLERTIMINGACCUMULATOR_H
 
 #include "scenario/gazebo/helpers.h"
 
@@ -37,19 +37,18 @@ namespace ignition::gazebo {
     // Inline bracket to help doxygen filtering.
     inline namespace IGNITION_GAZEBO_VERSION_NAMESPACE {
         namespace components {
-            /// \brief Fixed-size queue that stores a window of applied joint
-            ///        forces.
+            /// \brief Execution times of the controller of a model.
             ///
-            /// The queue is associated to a joint and it is filled at each
-            /// physics step with as many values as degrees of freedom.
-            using HistoryOfAppliedJointForces =
-                Component<scenario::gazebo::utils::FixedSizeQueue,
-                          class HistoryOfAppliedJointForcesTag>;
+            /// The component is associated to a model and it is updated by the
+            /// ControllerRunner system at every step of the controller.
+            using ControllerTimingAccumulator =
+                Component<scenario::gazebo::utils::ControllerTimingAccumulator,
+                          class ControllerTimingAccumulatorTag>;
             IGN_GAZEBO_REGISTER_COMPONENT(
-                "ign_gazebo_components.HistoryOfAppliedJointForces",
-                HistoryOfAppliedJointForces)
+                "ign_gazebo_components.ControllerTimingAccumulator",
+                ControllerTimingAccumulator)
         } // namespace components
     } // namespace IGNITION_GAZEBO_VERSION_NAMESPACE
 } // namespace ignition::gazebo
 
-#endif // IGNITION_GAZEBO_COMPONENTS_HISTORYOFAPPLIEDJOINTFORCES_H
+#endif // IGNITION_GAZEBO_COMPONENTS_CONTROLLERTIMINGACCUMULATOR_H
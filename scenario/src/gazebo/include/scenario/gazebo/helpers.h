@@ -32,6 +32,7 @@
 #include "scenario/gazebo/Model.h"
 #include "scenario/gazebo/World.h"
 #include "scenario/gazebo/exceptions.h"
+#include "scenario/gazebo/utils.h"
 
 #include <ignition/gazebo/Entity.hh>
 #include <ignition/gazebo/EntityComponentManager.hh>
@@ -50,12 +51,19 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
 #include <chrono>
-#include <deque>
+#include <cmath>
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -65,6 +73,9 @@ namespace scenario::gazebo::utils {
     getSdfRootFromFile(const std::string& sdfFileName);
     std::shared_ptr<sdf::Root>
     getSdfRootFromString(const std::string& sdfString);
+    // Load a new root from a clone of the elements, that retain their file path
+    std::shared_ptr<sdf::Root>
+    getSdfRootFromElement(const sdf::ElementPtr& element);
 
     const std::string ScenarioVerboseEnvVar = "SCENARIO_VERBOSE";
     bool verboseFromEnvironment();
@@ -81,37 +92,970 @@ namespace scenario::gazebo::utils {
 
     bool parentModelJustCreated(const GazeboEntity& gazeboEntity);
 
-    class FixedSizeQueue
+    /**
+     * Fixed-capacity ring buffer of rows of values stored in contiguous
+     * memory.
+     *
+     * Each row has the same number of values (the width), e.g. one value per
+     * joint DoF. Pushing a row when the buffer is full overwrites the oldest
+     * one without any allocation. The rows can be read in chronological order
+     * without copies through two contiguous spans: the first one starts from
+     * the oldest row and the second one, possibly empty, contains the rows
+     * stored after the wrap around.
+     */
+    class RingBuffer
     {
     public:
-        FixedSizeQueue(const size_t size = 100)
-            : m_size(size)
-            , m_deque(size, 0.0)
+        struct Span
+        {
+            const double* data = nullptr;
+            size_t size = 0;
+        };
+
+        /**
+         * Construct the buffer initialized with zero-valued rows.
+         *
+         * @param capacity The maximum number of rows.
+         * @param width The number of values of each row.
+         */
+        RingBuffer(const size_t capacity = 100, const size_t width = 1)
+            : m_capacity(capacity)
+            , m_width(width)
+            , m_size(capacity)
+            , m_data(capacity * width, 0.0)
         {}
 
-        void push(const double value)
+        inline size_t capacity() const { return m_capacity; }
+        inline size_t width() const { return m_width; }
+        inline size_t size() const { return m_size; }
+
+        inline void push(const double* row)
         {
-            if (m_deque.size() == m_size) {
-                m_deque.pop_front();
+            if (m_capacity == 0) {
+                return;
             }
 
-            m_deque.push_back(value);
+            std::copy(row, row + m_width, m_data.begin() + m_head * m_width);
+
+            m_head = (m_head + 1) % m_capacity;
+            m_size = std::min(m_size + 1, m_capacity);
         }
 
-        void resize(const size_t newSize)
+        inline void push(const std::vector<double>& row)
         {
-            m_size = newSize;
-            m_deque = std::deque<double>(newSize, 0.0);
+            assert(row.size() == m_width);
+            this->push(row.data());
+        }
+
+        /**
+         * Change the capacity of the buffer.
+         *
+         * The most recent rows are kept. If the capacity grows, the buffer is
+         * padded with zero-valued rows older than the existing ones.
+         *
+         * @param newCapacity The new maximum number of rows.
+         */
+        inline void resize(const size_t newCapacity)
+        {
+            if (newCapacity == m_capacity) {
+                return;
+            }
+
+            const std::vector<double> rows = this->toStdVector();
+            const size_t kept = std::min(m_size, newCapacity);
+
+            m_data.assign(newCapacity * m_width, 0.0);
+            std::copy(rows.end() - kept * m_width,
+                      rows.end(),
+                      m_data.end() - kept * m_width);
+
+            m_capacity = newCapacity;
+            m_size = newCapacity;
+            m_head = 0;
+        }
+
+        /**
+         * Get the chronological views of the stored values.
+         *
+         * @return The pair of spans that, concatenated, contain the rows from
+         * the oldest to the newest. The sizes are expressed in values.
+         */
+        inline std::pair<Span, Span> spans() const
+        {
+            if (m_size == 0) {
+                return {};
+            }
+
+            const size_t first = (m_head + m_capacity - m_size) % m_capacity;
+            const size_t firstRows = std::min(m_size, m_capacity - first);
+
+            return {{m_data.data() + first * m_width, firstRows * m_width},
+                    {m_data.data(), (m_size - firstRows) * m_width}};
         }
 
         inline std::vector<double> toStdVector() const
         {
-            return {m_deque.begin(), m_deque.end()};
+            const auto [first, second] = this->spans();
+
+            std::vector<double> values;
+            values.reserve(first.size + second.size);
+            values.insert(values.end(), first.data, first.data + first.size);
+            values.insert(
+                values.end(), second.data, second.data + second.size);
+
+            return values;
         }
 
     private:
+        size_t m_capacity;
+        size_t m_width;
         size_t m_size;
-        std::deque<double> m_deque;
+        size_t m_head = 0;
+        std::vector<double> m_data;
+    };
+
+    /**
+     * History of the signals of a joint.
+     *
+     * Each enabled signal is stored in its own ring buffer, whose rows have
+     * the size of the joint DoFs and are filled by the Physics system at every
+     * physics step.
+     */
+    class JointHistory
+    {
+    public:
+        static constexpr size_t NumOfSignals =
+            static_cast<size_t>(JointSignal::VelocityTarget) + 1;
+
+        inline bool enabled(const JointSignal signal) const
+        {
+            return m_buffers[index(signal)].has_value();
+        }
+
+        inline void enable(const JointSignal signal,
+                           const size_t capacity,
+                           const size_t width)
+        {
+            auto& buffer = m_buffers[index(signal)];
+
+            // Existing buffers keep their content
+            if (buffer.has_value() && buffer->width() == width) {
+                buffer->resize(capacity);
+                return;
+            }
+
+            buffer.emplace(capacity, width);
+        }
+
+        inline void disable(const JointSignal signal)
+        {
+            m_buffers[index(signal)].reset();
+        }
+
+        inline bool empty() const
+        {
+            return std::none_of(m_buffers.begin(),
+                                m_buffers.end(),
+                                [](const auto& b) { return b.has_value(); });
+        }
+
+        inline RingBuffer* buffer(const JointSignal signal)
+        {
+            auto& buffer = m_buffers[index(signal)];
+            return buffer.has_value() ? &buffer.value() : nullptr;
+        }
+
+        inline const RingBuffer* buffer(const JointSignal signal) const
+        {
+            const auto& buffer = m_buffers[index(signal)];
+            return buffer.has_value() ? &buffer.value() : nullptr;
+        }
+
+    private:
+        static inline size_t index(const JointSignal signal)
+        {
+            return static_cast<size_t>(signal);
+        }
+
+        std::array<std::optional<RingBuffer>, NumOfSignals> m_buffers;
+    };
+
+    /**
+     * Contiguous storage of the joint state of a model.
+     *
+     * The joint quantities are stored as separate arrays (struct of arrays)
+     * with the DoFs of all the joints serialized one after the other. The
+     * layout is defined once when the model is created and the values are
+     * refreshed by the Physics system after each physics step. Since the
+     * arrays are never reallocated after construction, pointers to their
+     * data remain valid for the entire lifetime of the object.
+     */
+    struct JointStateCache
+    {
+        JointStateCache() = default;
+        JointStateCache(const std::vector<ignition::gazebo::Entity>& entities,
+                        const std::vector<size_t>& jointDofs)
+            : joints(entities)
+        {
+            assert(entities.size() == jointDofs.size());
+
+            offsets.reserve(jointDofs.size() + 1);
+            offsets.push_back(0);
+
+            for (const size_t dofs : jointDofs) {
+                offsets.push_back(offsets.back() + dofs);
+            }
+
+            positions.resize(offsets.back(), 0.0);
+            velocities.resize(offsets.back(), 0.0);
+            accelerations.resize(offsets.back(), 0.0);
+            forces.resize(offsets.back(), 0.0);
+        }
+
+        inline size_t dofs() const { return positions.size(); }
+
+        // Joint entities, serialized as Model::jointNames
+        std::vector<ignition::gazebo::Entity> joints;
+        // Offsets of the first DoF of each joint (size: joints + 1)
+        std::vector<size_t> offsets;
+
+        std::vector<double> positions;
+        std::vector<double> velocities;
+        std::vector<double> accelerations;
+        std::vector<double> forces;
+
+        // True after the first refresh performed by the Physics system
+        bool populated = false;
+        // Simulation iteration of the last refresh
+        uint64_t iteration = 0;
+    };
+
+    /**
+     * Ring buffer of the joint state and base pose of a model recorded at
+     * every physics step.
+     *
+     * Every row of the buffers stores the data of a physics step. The rows
+     * of the joint data have the size of the model DoFs, serialized as
+     * Model::jointNames, and the rows of the base poses contain the position
+     * and the wxyz quaternion of the model. When the buffer is full, the
+     * oldest row is overwritten.
+     */
+    struct JointTrajectoryBuffer
+    {
+        static constexpr size_t PoseSize = 7;
+
+        JointTrajectoryBuffer() = default;
+        JointTrajectoryBuffer(const size_t capacity, const size_t dofs)
+            : capacity(capacity)
+            , dofs(dofs)
+        {
+            times.resize(capacity, 0.0);
+            positions.resize(capacity * dofs, 0.0);
+            velocities.resize(capacity * dofs, 0.0);
+            forces.resize(capacity * dofs, 0.0);
+            basePoses.resize(capacity * PoseSize, 0.0);
+        }
+
+        inline void push(const double time,
+                         const JointStateCache& state,
+                         const std::array<double, PoseSize>& basePose)
+        {
+            if (capacity == 0) {
+                return;
+            }
+
+            assert(state.dofs() == dofs);
+            times[head] = time;
+
+            std::copy(state.positions.begin(),
+                      state.positions.end(),
+                      positions.begin() + head * dofs);
+            std::copy(state.velocities.begin(),
+                      state.velocities.end(),
+                      velocities.begin() + head * dofs);
+            std::copy(state.forces.begin(),
+                      state.forces.end(),
+                      forces.begin() + head * dofs);
+            std::copy(basePose.begin(),
+                      basePose.end(),
+                      basePoses.begin() + head * PoseSize);
+
+            head = (head + 1) % capacity;
+            size = std::min(size + 1, capacity);
+        }
+
+        inline void clear()
+        {
+            head = 0;
+            size = 0;
+        }
+
+        // Copy the rows of a buffer from the oldest to the newest
+        inline std::vector<double> linearize(const std::vector<double>& buffer,
+                                             const size_t rowSize) const
+        {
+            std::vector<double> rows;
+
+            if (size == 0) {
+                return rows;
+            }
+
+            rows.reserve(size * rowSize);
+
+            // Rows are contiguous if the buffer did not wrap around
+            const size_t first = (head + capacity - size) % capacity;
+            const size_t firstChunk = std::min(size, capacity - first);
+
+            rows.insert(rows.end(),
+                        buffer.begin() + first * rowSize,
+                        buffer.begin() + (first + firstChunk) * rowSize);
+            rows.insert(rows.end(),
+                        buffer.begin(),
+                        buffer.begin() + (size - firstChunk) * rowSize);
+
+            return rows;
+        }
+
+        size_t capacity = 0;
+        size_t dofs = 0;
+
+        // Index of the next row to write and number of valid rows
+        size_t head = 0;
+        size_t size = 0;
+
+        std::vector<double> times;
+        std::vector<double> positions;
+        std::vector<double> velocities;
+        std::vector<double> forces;
+        std::vector<double> basePoses;
+    };
+
+    /**
+     * Index of the models that are part of a world.
+     *
+     * The registry maps the model names to their entities and stores the
+     * position of each name in the list of names, so that both insertion and
+     * removal are O(1). Removing a model moves the last name in its place,
+     * therefore the names are in insertion order only until the first
+     * removal. It is associated to a world entity and it is updated when
+     * models are created and removed, avoiding to scan the ECM for every
+     * query.
+     */
+    class ModelRegistry
+    {
+    public:
+        ModelRegistry() = default;
+
+        inline bool contains(const std::string& name) const
+        {
+            return m_entries.find(name) != m_entries.end();
+        }
+
+        inline ignition::gazebo::Entity entity(const std::string& name) const
+        {
+            const auto it = m_entries.find(name);
+            return it != m_entries.end() ? it->second.entity
+                                         : ignition::gazebo::kNullEntity;
+        }
+
+        inline const std::vector<std::string>& names() const
+        {
+            return m_names;
+        }
+
+        inline void add(const std::string& name,
+                        const ignition::gazebo::Entity entity)
+        {
+            if (m_entries.emplace(name, Entry{entity, m_names.size()}).second) {
+                m_modelNames.emplace(entity, name);
+                m_names.push_back(name);
+            }
+        }
+
+        inline void remove(const ignition::gazebo::Entity entity)
+        {
+            const auto it = m_modelNames.find(entity);
+
+            if (it == m_modelNames.end()) {
+                return;
+            }
+
+            const auto entryIt = m_entries.find(it->second);
+            assert(entryIt != m_entries.end());
+            const size_t index = entryIt->second.index;
+
+            // Move the last name in the slot of the removed one
+            if (index != m_names.size() - 1) {
+                m_names[index] = std::move(m_names.back());
+                m_entries.at(m_names[index]).index = index;
+            }
+
+            m_names.pop_back();
+            m_entries.erase(entryIt);
+            m_modelNames.erase(it);
+        }
+
+    private:
+        struct Entry
+        {
+            ignition::gazebo::Entity entity = ignition::gazebo::kNullEntity;
+            size_t index = 0;
+        };
+
+        std::vector<std::string> m_names;
+        std::unordered_map<std::string, Entry> m_entries;
+        std::unordered_map<ignition::gazebo::Entity, std::string> m_modelNames;
+    };
+
+    /**
+     * Contact point of a collision stored as plain data.
+     *
+     * The points are written by the Physics system directly from the contacts
+     * of the physics engine, without converting them to messages. They are
+     * expressed from the point of view of the collision that stores them:
+     * the force is the one applied to it, and the normal is flipped
+     * accordingly. The force and the normal are expressed in the world frame.
+     */
+    struct ContactPointData
+    {
+        ignition::gazebo::Entity collision = ignition::gazebo::kNullEntity;
+        ignition::gazebo::Entity otherCollision = ignition::gazebo::kNullEntity;
+
+        std::array<double, 3> position = {0, 0, 0};
+        std::array<double, 3> normal = {0, 0, 0};
+        std::array<double, 3> force = {0, 0, 0};
+        double depth = 0.0;
+    };
+
+    /**
+     * Contact data of a link accumulated over multiple physics steps.
+     *
+     * The Physics system adds the contact points of the link collisions at
+     * every step and finalizes the step with its duration. The data is reset
+     * at the beginning of each unpaused GazeboSimulator::run.
+     */
+    struct ContactAccumulator
+    {
+        inline void addPoint(const std::array<double, 3>& force)
+        {
+            for (size_t i = 0; i < 3; ++i) {
+                stepForce[i] += force[i];
+            }
+            ++stepPoints;
+        }
+
+        inline void endStep(const double dt)
+        {
+            ++steps;
+
+            if (stepPoints > 0) {
+                ++stepsInContact;
+                points += stepPoints;
+            }
+
+            double norm2 = 0.0;
+
+            for (size_t i = 0; i < 3; ++i) {
+                sumForce[i] += stepForce[i];
+                impulse[i] += stepForce[i] * dt;
+                norm2 += stepForce[i] * stepForce[i];
+            }
+
+            maxForce = std::max(maxForce, std::sqrt(norm2));
+
+            stepForce = {0, 0, 0};
+            stepPoints = 0;
+        }
+
+        inline void reset() { *this = ContactAccumulator(); }
+
+        // Data of the step being processed
+        std::array<double, 3> stepForce = {0, 0, 0};
+        size_t stepPoints = 0;
+
+        // Data accumulated since the last reset
+        size_t steps = 0;
+        size_t stepsInContact = 0;
+        size_t points = 0;
+        double maxForce = 0.0;
+        std::array<double, 3> sumForce = {0, 0, 0};
+        std::array<double, 3> impulse = {0, 0, 0};
+    };
+
+    /**
+     * Execution times of a controller accumulated over its steps.
+     *
+     * The accumulator is associated to a model and it is updated by the
+     * ControllerRunner system at every step of the controller. The
+     * percentiles are estimated from a histogram with logarithmic bins, whose
+     * resolution is 1/SubBins of an octave.
+     */
+    struct ControllerTimingAccumulator
+    {
+        static constexpr size_t SubBins = 8;
+        static constexpr size_t Octaves = 36; // From 1 ns to ~68 s
+        static constexpr size_t NumOfBins = SubBins * Octaves;
+
+        inline void add(const double seconds, const double period)
+        {
+            ++steps;
+            sumTime += seconds;
+            minTime = std::min(minTime, seconds);
+            maxTime = std::max(maxTime, seconds);
+
+            if (seconds > period) {
+                ++overruns;
+            }
+
+            ++histogram[bin(seconds)];
+        }
+
+        inline double percentile(const double p) const
+        {
+            if (steps == 0) {
+                return 0.0;
+            }
+
+            const auto rank = static_cast<uint64_t>(
+                std::max(1.0, std::ceil(p * static_cast<double>(steps))));
+            uint64_t cumulative = 0;
+
+            for (size_t i = 0; i < NumOfBins; ++i) {
+                cumulative += histogram[i];
+
+                if (cumulative >= rank) {
+                    // Upper edge of the bin, clamped to the observed range
+                    const double upper =
+                        std::exp2(static_cast<double>(i + 1) / SubBins) * 1e-9;
+                    return std::clamp(upper, minTime, maxTime);
+                }
+            }
+
+            return maxTime;
+        }
+
+        inline double meanTime() const
+        {
+            return steps > 0 ? sumTime / static_cast<double>(steps) : 0.0;
+        }
+
+        inline static size_t bin(const double seconds)
+        {
+            const double nanoseconds = seconds * 1e9;
+
+            if (!(nanoseconds > 1.0)) {
+                return 0;
+            }
+
+            const auto index =
+                static_cast<size_t>(std::log2(nanoseconds) * SubBins);
+            return std::min(index, NumOfBins - 1);
+        }
+
+        size_t steps = 0;
+        size_t overruns = 0;
+        double sumTime = 0.0;
+        double minTime = std::numeric_limits<double>::infinity();
+        double maxTime = 0.0;
+        std::array<uint64_t, NumOfBins> histogram = {};
+    };
+
+    /**
+     * Whitelist of the contacts reported for the links of a world.
+     *
+     * The filter is associated to a world entity. Each filtered link stores
+     * the bodies (links or models) whose contacts have to be reported, and
+     * the Physics system discards all the other contacts of the link before
+     * storing them in its contact buffers. Links without an entry report all
+     * their contacts. The contact messages of other systems are not filtered.
+     */
+    class ContactFilter
+    {
+    public:
+        ContactFilter() = default;
+
+        inline bool empty() const { return m_allowed.empty(); }
+
+        inline void set(const ignition::gazebo::Entity link,
+                        std::unordered_set<ignition::gazebo::Entity> bodies)
+        {
+            m_allowed[link] = std::move(bodies);
+        }
+
+        inline void remove(const ignition::gazebo::Entity link)
+        {
+            m_allowed.erase(link);
+        }
+
+        // Return nullptr if the contacts of the link are not filtered
+        inline const std::unordered_set<ignition::gazebo::Entity>*
+        allowed(const ignition::gazebo::Entity link) const
+        {
+            const auto it = m_allowed.find(link);
+            return it != m_allowed.end() ? &it->second : nullptr;
+        }
+
+    private:
+        std::unordered_map<ignition::gazebo::Entity,
+                           std::unordered_set<ignition::gazebo::Entity>>
+            m_allowed;
+    };
+
+    /**
+     * Queue of the joints with pending commands.
+     *
+     * The queue is associated to a world entity. The joints are enqueued
+     * when they receive a force or velocity command, or a state reset, and
+     * the Physics system applies the commands only to the enqueued joints,
+     * avoiding to process the passive joints at every step. Joints are stored
+     * only once, in the order they were enqueued.
+     *
+     * Systems that write the joint commands directly in the ECM do not use
+     * the queue. When they are inserted, the queue is marked as having
+     * external writers, and the Physics system also searches the ECM for the
+     * joints with pending commands.
+     */
+    class JointCommandQueue
+    {
+    public:
+        JointCommandQueue() = default;
+
+        inline void push(const ignition::gazebo::Entity joint)
+        {
+            if (m_enqueued.insert(joint).second) {
+                m_joints.push_back(joint);
+            }
+        }
+
+        inline const std::vector<ignition::gazebo::Entity>& joints() const
+        {
+            return m_joints;
+        }
+
+        inline bool empty() const { return m_joints.empty(); }
+
+        inline void clear()
+        {
+            m_joints.clear();
+            m_enqueued.clear();
+        }
+
+        inline void setExternalWriters(const bool externalWriters)
+        {
+            m_externalWriters = externalWriters;
+        }
+
+        inline bool externalWriters() const { return m_externalWriters; }
+
+    private:
+        bool m_externalWriters = false;
+        std::vector<ignition::gazebo::Entity> m_joints;
+        std::unordered_set<ignition::gazebo::Entity> m_enqueued;
+    };
+
+    /**
+     * Minimum jerk trajectory of a single DoF.
+     *
+     * The trajectory is a quintic polynomial that moves from an initial
+     * position, velocity and acceleration to a target position, reached with
+     * zero velocity and acceleration after the given duration. Planning a new
+     * trajectory from the state of the current one keeps the reference
+     * continuous up to the acceleration when the target changes in motion.
+     */
+    struct MinimumJerkTrajectory
+    {
+        inline void plan(const double startTime,
+                         const double duration,
+                         const double position,
+                         const double velocity,
+                         const double acceleration,
+                         const double targetPosition)
+        {
+            t0 = startTime;
+            T = std::max(duration, 0.0);
+            target = targetPosition;
+
+            const double delta = targetPosition - position;
+            const double T2 = T * T;
+            const double T3 = T2 * T;
+
+            a = {position, velocity, acceleration / 2, 0.0, 0.0, 0.0};
+
+            if (T <= 0) {
+                return;
+            }
+
+            a[3] = (20 * delta - 12 * velocity * T - 3 * acceleration * T2)
+                   / (2 * T3);
+            a[4] = (-30 * delta + 16 * velocity * T + 3 * acceleration * T2)
+                   / (2 * T3 * T);
+            a[5] = (12 * delta - 6 * velocity * T - acceleration * T2)
+                   / (2 * T3 * T2);
+        }
+
+        // Position, velocity and acceleration at the given time. The target
+        // is held after the end of the trajectory.
+        inline std::array<double, 3> evaluate(const double time) const
+        {
+            if (time - t0 >= T) {
+                return {target, 0.0, 0.0};
+            }
+
+            const double t = std::max(time - t0, 0.0);
+            const double t2 = t * t;
+            const double t3 = t2 * t;
+
+            const double position = a[0] + a[1] * t + a[2] * t2 + a[3] * t3
+                                    + a[4] * t3 * t + a[5] * t3 * t2;
+            const double velocity = a[1] + 2 * a[2] * t + 3 * a[3] * t2
+                                    + 4 * a[4] * t3 + 5 * a[5] * t3 * t;
+            const double acceleration =
+                2 * a[2] + 6 * a[3] * t + 12 * a[4] * t2 + 20 * a[5] * t3;
+
+            return {position, velocity, acceleration};
+        }
+
+        double t0 = 0;
+        double T = 0;
+        double target = 0;
+        std::array<double, 6> a = {};
+    };
+
+    /**
+     * Bank of the PIDs of the joints of a model controlled by the
+     * JointController plugin.
+     *
+     * The bank caches the joints of the model grouped by control mode. It is
+     * invalidated when the control mode or the PID of a joint changes, and
+     * the JointController rebuilds it at its next update. The gains and the
+     * state of the PIDs of the joints controlled in Position,
+     * PositionInterpolated and Velocity are stored as separate arrays
+     * (struct of arrays), so that all the PIDs of the model are evaluated in
+     * a single loop that the compiler can vectorize. The PIDs mirror
+     * ignition::math::PID. When the bank is rebuilt, the PIDs of the
+     * invalidated joints are loaded from their JointPID components, and the
+     * other PIDs keep their state.
+     */
+    struct JointPIDBank
+    {
+        inline size_t size() const { return pidJoints.size(); }
+
+        // Whether the bank has to be rebuilt by the JointController
+        inline bool valid() const { return !joints.empty(); }
+
+        // Invalidate the PID of a joint, that is loaded again from its JointPID
+        // component when the JointController rebuilds the bank
+        inline void invalidate(const ignition::gazebo::Entity joint)
+        {
+            joints.clear();
+            modes.clear();
+            invalidatedJoints.push_back(joint);
+        }
+
+        // Whether the PID of a joint has been invalidated since the last build
+        inline bool invalidated(const ignition::gazebo::Entity joint) const
+        {
+            return std::find(invalidatedJoints.begin(),
+                             invalidatedJoints.end(),
+                             joint)
+                   != invalidatedJoints.end();
+        }
+
+        // Copy the state of the PID of a joint from the bank before a rebuild
+        inline void restore(const size_t index,
+                            const JointPIDBank& previous,
+                            const size_t previousIndex)
+        {
+            iErr[index] = previous.iErr[previousIndex];
+            pErrLast[index] = previous.pErrLast[previousIndex];
+            cmd[index] = previous.cmd[previousIndex];
+        }
+
+        // Clear the bank, that gets rebuilt by the JointController loading all
+        // the PIDs from the JointPID components
+        inline void clear()
+        {
+            joints.clear();
+            invalidatedJoints.clear();
+            modes.clear();
+            pidJoints.clear();
+            interpolatedBegin = 0;
+            numPositionControlled = 0;
+            trajectories.clear();
+            lastTargetTime.reset();
+            velocityFollowerJoints.clear();
+
+            for (auto* array : arrays()) {
+                array->clear();
+            }
+        }
+
+        // Append a PID, initializing its gains and state from an existing one
+        inline void push(const ignition::gazebo::Entity joint,
+                         const ignition::math::PID& pid)
+        {
+            pidJoints.push_back(joint);
+
+            for (auto* array : arrays()) {
+                array->push_back(0.0);
+            }
+
+            load(pidJoints.size() - 1, pid);
+        }
+
+        inline void load(const size_t index, const ignition::math::PID& pid)
+        {
+            pGain[index] = pid.PGain();
+            iGain[index] = pid.IGain();
+            dGain[index] = pid.DGain();
+            iMin[index] = pid.IMin();
+            iMax[index] = pid.IMax();
+            cmdMin[index] = pid.CmdMin();
+            cmdMax[index] = pid.CmdMax();
+            cmdOffset[index] = pid.CmdOffset();
+
+            double pErr, dErr;
+            pid.GetErrors(pErr, iErr[index], dErr);
+            pErrLast[index] = pErr;
+            cmd[index] = pid.Cmd();
+        }
+
+        // Update all the PIDs from the errors, storing the new commands
+        inline void update(const std::chrono::duration<double>& dt)
+        {
+            if (dt.count() <= 0) {
+                return;
+            }
+
+            const size_t n = size();
+            const double step = dt.count();
+            const double invStep = 1.0 / step;
+
+            const double* const e = error.data();
+            const double* const kp = pGain.data();
+            const double* const ki = iGain.data();
+            const double* const kd = dGain.data();
+            const double* const iLow = iMin.data();
+            const double* const iHigh = iMax.data();
+            const double* const cmdLow = cmdMin.data();
+            const double* const cmdHigh = cmdMax.data();
+            const double* const offset = cmdOffset.data();
+            double* const integral = iErr.data();
+            double* const last = pErrLast.data();
+            double* const out = cmd.data();
+
+            // The terms are computed in separate loops with no branches, so
+            // that each of them is vectorized
+
+            // Integral term, limited only if the limits are consistent
+            for (size_t i = 0; i < n; ++i) {
+                const double in = integral[i] + ki[i] * step * e[i];
+                const double inLimited =
+                    std::min(std::max(in, iLow[i]), iHigh[i]);
+                integral[i] = iHigh[i] >= iLow[i] ? inLimited : in;
+            }
+
+            // Command, limited only if the limits are consistent
+            for (size_t i = 0; i < n; ++i) {
+                const double derivative = (e[i] - last[i]) * invStep;
+                const double c = -kp[i] * e[i] - integral[i]
+                                 - kd[i] * derivative + offset[i];
+                const double cLimited =
+                    std::min(std::max(c, cmdLow[i]), cmdHigh[i]);
+                out[i] = cmdHigh[i] >= cmdLow[i] ? cLimited : c;
+            }
+
+            std::copy(e, e + n, last);
+        }
+
+        // Joints of the model and their control mode when the bank was built
+        std::vector<ignition::gazebo::Entity> joints;
+        std::vector<scenario::core::JointControlMode> modes;
+
+        // Joints whose PID has been invalidated since the last build
+        std::vector<ignition::gazebo::Entity> invalidatedJoints;
+
+        // Joints controlled by a PID. The joints controlled in Position come
+        // first, followed by the ones controlled in PositionInterpolated,
+        // starting at interpolatedBegin, and by the ones controlled in
+        // Velocity, starting at numPositionControlled.
+        std::vector<ignition::gazebo::Entity> pidJoints;
+        size_t interpolatedBegin = 0;
+        size_t numPositionControlled = 0;
+
+        // Trajectories of the joints controlled in PositionInterpolated
+        std::vector<MinimumJerkTrajectory> trajectories;
+
+        // Simulated time of the last change of the interpolated targets
+        std::optional<double> lastTargetTime;
+
+        // Joints controlled in VelocityFollowerDart
+        std::vector<ignition::gazebo::Entity> velocityFollowerJoints;
+
+        // Gains of the PIDs
+        std::vector<double> pGain;
+        std::vector<double> iGain;
+        std::vector<double> dGain;
+        std::vector<double> iMin;
+        std::vector<double> iMax;
+        std::vector<double> cmdMin;
+        std::vector<double> cmdMax;
+        std::vector<double> cmdOffset;
+
+        // Inputs, state and outputs of the PIDs
+        std::vector<double> error;
+        std::vector<double> iErr;
+        std::vector<double> pErrLast;
+        std::vector<double> cmd;
+
+    private:
+        inline std::array<std::vector<double>*, 12> arrays()
+        {
+            return {&pGain,
+                    &iGain,
+                    &dGain,
+                    &iMin,
+                    &iMax,
+                    &cmdMin,
+                    &cmdMax,
+                    &cmdOffset,
+                    &error,
+                    &iErr,
+                    &pErrLast,
+                    &cmd};
+        }
+    };
+
+    /**
+     * Process-wide cache of the SDF files loaded from the filesystem.
+     *
+     * Files are identified by their absolute path, modification time and
+     * size. The cache stores the parsed elements and every lookup returns a
+     * new sdf::Root loaded from a clone of them, that can be freely modified.
+     * The elements retain the path of the file, that is used to resolve
+     * relative URIs of the resources.
+     */
+    class SdfCache
+    {
+    public:
+        static SdfCache& Instance();
+
+        // Return nullptr if the file is not cached or if it changed
+        std::shared_ptr<sdf::Root> get(const std::string& fileName);
+        void insert(const std::string& fileName, const sdf::Root& root);
+
+        bool evict(const std::string& fileName);
+        void clear();
+        SdfCacheStats stats() const;
+
+    private:
+        SdfCache() = default;
+
+        struct Entry;
+
+        mutable std::mutex m_mutex;
+        SdfCacheStats m_stats;
+        std::unordered_map<std::string, std::shared_ptr<Entry>> m_entries;
     };
 
     template <typename ComponentTypeT, typename ComponentDataTypeT>
@@ -179,6 +1123,17 @@ namespace scenario::gazebo::utils {
 
     std::shared_ptr<Model> getParentModel(const GazeboEntity& gazeboEntity);
 
+    void enqueueJointCommand(ignition::gazebo::EntityComponentManager* ecm,
+                             const ignition::gazebo::Entity jointEntity);
+
+    void setExternalJointCommandWriters(
+        ignition::gazebo::EntityComponentManager* ecm,
+        const ignition::gazebo::Entity entity);
+
+    bool writesJointCommands(const std::string& className);
+
+    bool hasJointCommandWriters(const sdf::ElementPtr& element);
+
     template <typename ComponentType>
     ignition::gazebo::Entity getFirstParentEntityWithComponent(
         ignition::gazebo::EntityComponentManager* ecm,
@@ -28,6 +28,7 @@
 #define SCENARIO_GAZEBO_UTILS_H
 
 #include "scenario/gazebo/GazeboEntity.h"
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
@@ -259,6 +260,45 @@ namespace scenario::gazebo::utils {
                                     const std::string& libName,
                                     const std::string& className,
                                     const std::string& context = "");
+
+    /**
+     * Statistics of the process-wide cache of SDF files.
+     *
+     * Files loaded from the filesystem (e.g. with ``World::insertModel``) are
+     * parsed, and converted from URDF, only the first time. Following loads
+     * are served from the cache as long as the modification time and the size
+     * of the file do not change.
+     */
+    struct SdfCacheStats
+    {
+        /// The number of loads served by the cache.
+        size_t hits = 0;
+        /// The number of loads that parsed the file.
+        size_t misses = 0;
+        /// The number of files stored in the cache.
+        size_t entries = 0;
+    };
+
+    /**
+     * Get the statistics of the cache of SDF files.
+     *
+     * @return The statistics of the cache.
+     */
+    SdfCacheStats sdfCacheStats();
+
+    /**
+     * Remove a file from the cache of SDF files.
+     *
+     * @param fileName The path to the file.
+     * @return True if the file was cached, false otherwise.
+     */
+    bool evictSdfCache(const std::string& fileName);
+
+    /**
+     * Remove all the files from the cache of SDF files and reset its
+     * statistics.
+     */
+    void clearSdfCache();
 } // namespace scenario::gazebo::utils
 
 #endif // SCENARIO_GAZEBO_UTILS_H
@@ -29,6 +29,9 @@
 #include "scenario/core/utils/signals.h"
 #include "scenario/gazebo/Log.h"
 #include "scenario/gazebo/World.h"
+#include "scenario/gazebo/components/ContactAccumulator.h"
+#include "scenario/gazebo/components/JointTrajectoryBuffer.h"
+#include "scenario/gazebo/components/ModelRegistry.h"
 #include "scenario/gazebo/components/SimulatedTime.h"
 #include "scenario/gazebo/components/Timestamp.h"
 #include "scenario/gazebo/helpers.h"
@@ -38,7 +41,9 @@
 #include <ignition/gazebo/Server.hh>
 #include <ignition/gazebo/ServerConfig.hh>
 #include <ignition/gazebo/Util.hh>
+#include <ignition/gazebo/components/Model.hh>
 #include <ignition/gazebo/components/Name.hh>
+#include <ignition/gazebo/components/ParentEntity.hh>
 #include <ignition/gazebo/components/Physics.hh>
 #include <ignition/gazebo/components/PhysicsCmd.hh>
 #include <ignition/gazebo/components/Pose.hh>
@@ -51,17 +56,23 @@
 #include <cassert>
 #include <chrono>
 #include <cmath>
+#include <condition_variable>
 #include <csignal>
 #include <functional>
+#include <future>
 #include <limits>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 
 using namespace scenario::gazebo;
 
 namespace scenario::gazebo::detail {
     class ECMProvider;
+    class WorkerPool;
+    class StartupTimer;
     struct PhysicsData;
     struct SimulationResources
     {
@@ -82,6 +93,7 @@ struct detail::PhysicsData
 class scenario::gazebo::detail::ECMProvider final
     : public ignition::gazebo::System
     , public ignition::gazebo::ISystemConfigure
+    , public ignition::gazebo::ISystemPostUpdate
 {
 public:
     ECMProvider()
@@ -93,9 +105,68 @@ public:
                    ignition::gazebo::EntityComponentManager& ecm,
                    ignition::gazebo::EventManager& eventMgr);
 
+    // Keep the model registry of the world in sync with the ECM
+    void PostUpdate(const ignition::gazebo::UpdateInfo& info,
+                    const ignition::gazebo::EntityComponentManager& ecm);
+
+    // Wait until the system has been configured by the server.
+    // Return true if the ECM and EventManager pointers are valid.
+    bool waitConfigured(const std::chrono::steady_clock::duration& timeout);
+
     std::string worldName;
     ignition::gazebo::EventManager* eventMgr = nullptr;
     ignition::gazebo::EntityComponentManager* ecm = nullptr;
+
+private:
+    ignition::gazebo::Entity worldEntity = ignition::gazebo::kNullEntity;
+    std::shared_ptr<utils::ModelRegistry> modelRegistry;
+
+    std::promise<bool> configured;
+    std::future<bool> ready = configured.get_future();
+};
+
+class scenario::gazebo::detail::StartupTimer final
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Accumulate the time elapsed since the previous call in the given phase
+    void toc(const std::string& phase);
+
+    // Print the duration of all the phases
+    void report() const;
+
+private:
+    Clock::time_point tic = Clock::now();
+    std::vector<std::pair<std::string, Clock::duration>> phases;
+};
+
+class scenario::gazebo::detail::WorkerPool final
+{
+public:
+    using Task = std::function<bool()>;
+
+    explicit WorkerPool(const size_t numOfThreads);
+    ~WorkerPool();
+
+    // Execute the tasks and wait their completion.
+    // Return true only if all tasks succeeded.
+    bool run(const std::vector<Task>& tasks);
+
+private:
+    void worker();
+
+    std::mutex mutex;
+    std::condition_variable cvWork;
+    std::condition_variable cvDone;
+
+    bool stop = false;
+    bool success = true;
+    size_t nextTask = 0;
+    size_t pendingTasks = 0;
+    const std::vector<Task>* tasks = nullptr;
+
+    std::vector<std::thread> threads;
 };
 
 // ==============
@@ -115,14 +186,34 @@ public:
         std::shared_ptr<ignition::gazebo::Server> server;
     } gazebo;
 
+    struct
+    {
+        bool enabled = false;
+        size_t numOfThreads = 0;
+        std::unique_ptr<detail::WorkerPool> pool;
+    } parallel;
+
+    // In serial mode it contains only gazebo.server, that simulates all the
+    // worlds. In parallel mode it contains a server for each world, and
+    // gazebo.server is the server of the first world.
+    std::vector<std::shared_ptr<ignition::gazebo::Server>> servers;
+
     using WorldName = std::string;
     using GazeboWorldPtr = std::shared_ptr<scenario::gazebo::World>;
 
     std::unordered_map<WorldName, GazeboWorldPtr> worlds;
     std::unordered_map<WorldName, detail::SimulationResources> resources;
 
+    detail::StartupTimer startupTimer;
+
     bool insertSDFWorld(const sdf::World& world);
     std::shared_ptr<ignition::gazebo::Server> getServer();
+    bool runServers(const bool paused,
+                    const size_t iterations,
+                    const bool deterministic);
+
+    std::shared_ptr<ignition::gazebo::Server>
+    createServer(const std::string& sdfString, const size_t numOfWorlds);
 
     static std::shared_ptr<World>
     CreateGazeboWorld(const std::string& worldName,
@@ -293,6 +384,39 @@ bool GazeboSimulator::run(const bool paused)
         }
     }
 
+    // The contact statistics and the recorded trajectories refer to the
+    // physics steps of the last unpaused run. Paused runs do not step the
+    // physics and keep them unchanged.
+    if (!paused) {
+        for (const auto& worldName : this->worldNames()) {
+
+            assert(this->pImpl->resources.find(worldName)
+                   != this->pImpl->resources.end());
+            auto* ecm = this->pImpl->resources.at(worldName).ecm;
+
+            ecm->Each<ignition::gazebo::components::ContactAccumulator>(
+                [&](const ignition::gazebo::Entity&,
+                    ignition::gazebo::components::ContactAccumulator*
+                        accumulator) -> bool {
+                    accumulator->Data().reset();
+                    return true;
+                });
+
+            ecm->Each<ignition::gazebo::components::JointTrajectoryBuffer>(
+                [&](const ignition::gazebo::Entity&,
+                    ignition::gazebo::components::JointTrajectoryBuffer*
+                        buffer) -> bool {
+                    buffer->Data().clear();
+                    return true;
+                });
+        }
+    }
+
+    // Step the worlds in parallel, each of them has its own server
+    if (pImpl->parallel.pool) {
+        return pImpl->runServers(paused, iterations, deterministic);
+    }
+
     // Paused simulation run
     if (paused && !server->RunOnce(/*paused=*/true)) {
         sError << "The server couldn't execute the paused step" << std::endl;
@@ -404,7 +528,11 @@ bool GazeboSimulator::close()
         this->pause();
     }
 
+    // Stop the worker threads
+    pImpl->parallel.pool.reset();
+
     // Delete the simulator
+    pImpl->servers.clear();
     pImpl->gazebo.server.reset();
 
     return true;
@@ -423,6 +551,14 @@ bool GazeboSimulator::pause()
         return true;
     }
 
+    if (pImpl->parallel.pool) {
+        for (auto& server : pImpl->servers) {
+            server->SetPaused(true, /*worldIndex=*/0);
+        }
+
+        return !this->running();
+    }
+
     const size_t numOfWorlds = this->worldNames().size();
 
     for (unsigned worldIdx = 0; worldIdx < numOfWorlds; ++worldIdx) {
@@ -439,7 +575,9 @@ bool GazeboSimulator::running() const
         return false;
     }
 
-    return pImpl->gazebo.server->Running();
+    return std::any_of(pImpl->servers.begin(),
+                       pImpl->servers.end(),
+                       [](const auto& server) { return server->Running(); });
 }
 
 bool GazeboSimulator::insertWorldFromSDF(const std::string& worldFile,
@@ -542,6 +680,37 @@ bool GazeboSimulator::insertWorldsFromSDF(
     return true;
 }
 
+bool GazeboSimulator::enableParallelStepping(const size_t numOfThreads)
+{
+    if (this->initialized()) {
+        sError << "Parallel stepping must be enabled before the initialization"
+               << std::endl;
+        return false;
+    }
+
+    pImpl->parallel.enabled = true;
+    pImpl->parallel.numOfThreads =
+        numOfThreads != 0
+            ? numOfThreads
+            : std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+
+    return true;
+}
+
+size_t GazeboSimulator::parallelSteppingThreads() const
+{
+    if (!pImpl->parallel.enabled) {
+        return 0;
+    }
+
+    // After the initialization, return the actual size of the pool
+    if (this->initialized()) {
+        return pImpl->parallel.pool ? pImpl->parallel.numOfThreads : 0;
+    }
+
+    return pImpl->parallel.numOfThreads;
+}
+
 std::vector<std::string> GazeboSimulator::worldNames() const
 {
     if (!this->initialized()) {
@@ -611,6 +780,7 @@ void detail::ECMProvider::Configure(
             entity, ignition::gazebo::components::World::typeId)) {
         sError << "The ECMProvider system was not inserted "
                << "in a world element" << std::endl;
+        this->configured.set_value(false);
         return;
     }
 
@@ -619,9 +789,111 @@ void detail::ECMProvider::Configure(
 
     this->ecm = &ecm;
     this->eventMgr = &eventMgr;
+    this->worldEntity = entity;
+
+    // Create the registry of the models, that is kept updated in PostUpdate
+    this->modelRegistry = std::make_shared<utils::ModelRegistry>();
+
+    ecm.Each<ignition::gazebo::components::Model,
+             ignition::gazebo::components::Name,
+             ignition::gazebo::components::ParentEntity>(
+        [&](const ignition::gazebo::Entity& modelEntity,
+            const ignition::gazebo::components::Model*,
+            const ignition::gazebo::components::Name* name,
+            const ignition::gazebo::components::ParentEntity* parent) -> bool {
+            if (parent->Data() == entity) {
+                this->modelRegistry->add(name->Data(), modelEntity);
+            }
+            return true;
+        });
+
+    utils::setComponentData<ignition::gazebo::components::ModelRegistry>(
+        &ecm, entity, this->modelRegistry);
 
     sDebug << "World '" << this->worldName
            << "' successfully processed by ECMProvider" << std::endl;
+
+    // Signal that the resources of the world are ready
+    this->configured.set_value(true);
+}
+
+void detail::ECMProvider::PostUpdate(
+    const ignition::gazebo::UpdateInfo& /*info*/,
+    const ignition::gazebo::EntityComponentManager& ecm)
+{
+    if (!this->modelRegistry) {
+        return;
+    }
+
+    // Models created in this step, or in between the previous step and this
+    // one. Those inserted with World::insertModel are already registered.
+    ecm.EachNew<ignition::gazebo::components::Model,
+                ignition::gazebo::components::Name,
+                ignition::gazebo::components::ParentEntity>(
+        [&](const ignition::gazebo::Entity& modelEntity,
+            const ignition::gazebo::components::Model*,
+            const ignition::gazebo::components::Name* name,
+            const ignition::gazebo::components::ParentEntity* parent) -> bool {
+            if (parent->Data() == this->worldEntity) {
+                this->modelRegistry->add(name->Data(), modelEntity);
+            }
+            return true;
+        });
+
+    // Models that are going to be removed at the end of this step
+    ecm.EachRemoved<ignition::gazebo::components::Model>(
+        [&](const ignition::gazebo::Entity& modelEntity,
+            const ignition::gazebo::components::Model*) -> bool {
+            this->modelRegistry->remove(modelEntity);
+            return true;
+        });
+}
+
+bool detail::ECMProvider::waitConfigured(
+    const std::chrono::steady_clock::duration& timeout)
+{
+    if (this->ready.wait_for(timeout) != std::future_status::ready) {
+        sError << "Timeout while waiting the configuration of ECMProvider"
+               << std::endl;
+        return false;
+    }
+
+    return this->ready.get();
+}
+
+void detail::StartupTimer::toc(const std::string& phase)
+{
+    const auto now = Clock::now();
+    const auto elapsed = now - this->tic;
+    this->tic = now;
+
+    auto it = std::find_if(this->phases.begin(),
+                           this->phases.end(),
+                           [&](const auto& p) { return p.first == phase; });
+
+    if (it == this->phases.end()) {
+        this->phases.emplace_back(phase, elapsed);
+    }
+    else {
+        it->second += elapsed;
+    }
+}
+
+void detail::StartupTimer::report() const
+{
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    Clock::duration total = Clock::duration::zero();
+
+    sDebug << "Startup timing report:" << std::endl;
+
+    for (const auto& [phase, duration] : this->phases) {
+        total += duration;
+        sDebug << "  " << phase << ": " << Milliseconds(duration).count()
+               << " ms" << std::endl;
+    }
+
+    sDebug << "  total: " << Milliseconds(total).count() << " ms"
+           << std::endl;
 }
 
 bool GazeboSimulator::Impl::insertSDFWorld(const sdf::World& world)
@@ -661,6 +933,8 @@ std::shared_ptr<ignition::gazebo::Server> GazeboSimulator::Impl::getServer()
     // Create the server
     // =================
 
+    startupTimer = {};
+
     if (gazebo.numOfIterations == 0) {
         sError << "Non-deterministic mode (iterations=0) is not "
                << "currently supported" << std::endl;
@@ -693,6 +967,8 @@ std::shared_ptr<ignition::gazebo::Server> GazeboSimulator::Impl::getServer()
         std::cout << root.Element()->ToString("") << std::endl;
     }
 
+    startupTimer.toc("SDF parsing");
+
     // Set the following environment variable to disable loading the default
     // server plugins, which include upstream's Physics that is not compatible.
     // https://github.com/ignitionrobotics/ign-gazebo/pull/281
@@ -707,46 +983,52 @@ std::shared_ptr<ignition::gazebo::Server> GazeboSimulator::Impl::getServer()
         return nullptr;
     }
 
-    ignition::gazebo::ServerConfig config;
-    config.SetSeed(0);
-    config.SetUseLevels(false);
-    config.SetSdfString(root.Element()->ToString(""));
+    std::vector<std::shared_ptr<ignition::gazebo::Server>> servers;
 
-    // Create the server.
-    // The worlds are initialized with the physics parameters
-    // (rtf and physics step) defined in the SDF.
-    // They get overridden below.
-    auto server = std::make_shared<ignition::gazebo::Server>(config);
-    assert(server);
+    if (parallel.enabled && root.WorldCount() > 1) {
+        // Create a server for each world so that they can be stepped
+        // concurrently without sharing any state
+        for (size_t worldIdx = 0; worldIdx < root.WorldCount(); ++worldIdx) {
 
-    // Add a Configure-only system to get the ECM pointer
-    for (size_t worldIdx = 0; worldIdx < root.WorldCount(); ++worldIdx) {
+            const auto worldRoot = sdf::SDF::WrapInRoot(
+                root.WorldByIndex(worldIdx)->Element()->Clone());
 
-        auto provider = std::make_shared<detail::ECMProvider>();
-        if (const auto ok = server->AddSystem(provider, worldIdx); !ok) {
-            sError << "Failed to insert ECMProvider to world " << worldIdx
-                   << std::endl;
+            auto server = this->createServer(worldRoot->ToString(""), 1);
+
+            if (!server) {
+                sError << "Failed to create the server of world " << worldIdx
+                       << std::endl;
+                return nullptr;
+            }
+
+            servers.push_back(server);
+        }
+    }
+    else {
+        // Create a single server that simulates all the worlds
+        auto server = this->createServer(root.Element()->ToString(""),
+                                         root.WorldCount());
+
+        if (!server) {
             return nullptr;
         }
 
-        // Get the ECM and EventManager pointers
-        detail::SimulationResources resources;
-        resources.ecm = provider->ecm;
-        resources.eventMgr = provider->eventMgr;
-        this->resources[provider->worldName] = resources;
+        servers.push_back(server);
     }
 
-    std::this_thread::sleep_for(std::chrono::seconds(3));
-
     sDebug << "Starting the gazebo server" << std::endl;
 
     // TODO: is this redundant now?
-    if (!server->RunOnce(/*paused=*/true)) {
-        sError << "Failed to initialize the first gazebo server run"
-               << std::endl;
-        return nullptr;
+    for (auto& server : servers) {
+        if (!server->RunOnce(/*paused=*/true)) {
+            sError << "Failed to initialize the first gazebo server run"
+                   << std::endl;
+            return nullptr;
+        }
     }
 
+    startupTimer.toc("first RunOnce");
+
     if (!gazebo.physics.valid()) {
         sError << "The physics parameters are not valid" << std::endl;
         return nullptr;
@@ -771,18 +1053,44 @@ std::shared_ptr<ignition::gazebo::Server> GazeboSimulator::Impl::getServer()
         physics.set_max_step_size(gazebo.physics.maxStepSize);
         physics.set_real_time_factor(gazebo.physics.rtf);
         physics.set_real_time_update_rate(gazebo.physics.realTimeUpdateRate);
+
+        if (servers.size() == 1) {
+            continue;
+        }
+
+        // The default collision detector of DART is ODE, that relies on
+        // global state and cannot be stepped concurrently. Worlds that do not
+        // select any detector use bullet, that keeps its state in the world.
+        auto& collisionDetector = utils::getComponentData<
+            ignition::gazebo::components::PhysicsCollisionDetector>(
+            resources.ecm, worldEntity);
+
+        if (collisionDetector.empty()) {
+            collisionDetector = "bullet";
+        }
+
+        if (collisionDetector == "ode") {
+            sError << "World '" << worldName << "' uses the ODE collision "
+                   << "detector, that does not support parallel stepping"
+                   << std::endl;
+            return nullptr;
+        }
     }
 
     // Step the server to process the physics parameters.
     // This call executes SimulationRunner::SetStepSize, updating the
     // rate at which all systems are called.
-    // Note: it processes only the parameters of the first world.
-    if (!server->RunOnce(/*paused=*/true)) {
-        sError << "Failed to step the server to configure the physics"
-               << std::endl;
-        return nullptr;
+    // Note: it processes only the parameters of the first world of a server.
+    for (auto& server : servers) {
+        if (!server->RunOnce(/*paused=*/true)) {
+            sError << "Failed to step the server to configure the physics"
+                   << std::endl;
+            return nullptr;
+        }
     }
 
+    startupTimer.toc("physics configuration");
+
     for (size_t worldIdx = 0; worldIdx < root.WorldCount(); ++worldIdx) {
         // Get the world name
         const auto& worldName = root.WorldByIndex(worldIdx)->Name();
@@ -803,16 +1111,197 @@ std::shared_ptr<ignition::gazebo::Server> GazeboSimulator::Impl::getServer()
             return nullptr;
         }
 
+        // Plugins of the world and its models could write joint commands
+        // directly in the ECM
+        if (utils::hasJointCommandWriters(
+                root.WorldByIndex(worldIdx)->Element())) {
+            utils::setExternalJointCommandWriters(world->ecm(),
+                                                  world->entity());
+        }
+
         // Cache the world object
         assert(this->worlds.find(worldName) == this->worlds.end());
         this->worlds[worldName] = world;
     }
 
+    startupTimer.toc("world caching");
+
+    if (servers.size() > 1) {
+        parallel.numOfThreads =
+            std::min(parallel.numOfThreads, servers.size());
+        parallel.pool =
+            std::make_unique<detail::WorkerPool>(parallel.numOfThreads);
+
+        sDebug << "Stepping " << servers.size() << " worlds with "
+               << parallel.numOfThreads << " threads" << std::endl;
+    }
+
+    startupTimer.report();
+
     // Store and return the server
-    gazebo.server = server;
+    this->servers = servers;
+    gazebo.server = servers.front();
     return gazebo.server;
 }
 
+std::shared_ptr<ignition::gazebo::Server>
+GazeboSimulator::Impl::createServer(const std::string& sdfString,
+                                    const size_t numOfWorlds)
+{
+    ignition::gazebo::ServerConfig config;
+    config.SetSeed(0);
+    config.SetUseLevels(false);
+    config.SetSdfString(sdfString);
+
+    // Create the server.
+    // The worlds are initialized with the physics parameters
+    // (rtf and physics step) defined in the SDF.
+    // They get overridden after the first run.
+    auto server = std::make_shared<ignition::gazebo::Server>(config);
+    assert(server);
+
+    startupTimer.toc("server construction");
+
+    // Add a Configure-only system to get the ECM pointer
+    std::vector<std::shared_ptr<detail::ECMProvider>> providers;
+
+    for (size_t worldIdx = 0; worldIdx < numOfWorlds; ++worldIdx) {
+
+        auto provider = std::make_shared<detail::ECMProvider>();
+        if (const auto ok = server->AddSystem(provider, worldIdx); !ok) {
+            sError << "Failed to insert ECMProvider to world " << worldIdx
+                   << std::endl;
+            return nullptr;
+        }
+
+        providers.push_back(provider);
+    }
+
+    // Wait that the server configured the systems. Their resources are valid
+    // only afterwards.
+    for (const auto& provider : providers) {
+        if (!provider->waitConfigured(std::chrono::seconds(30))) {
+            sError << "Failed to get the resources of the world" << std::endl;
+            return nullptr;
+        }
+
+        // Get the ECM and EventManager pointers
+        detail::SimulationResources resources;
+        resources.ecm = provider->ecm;
+        resources.eventMgr = provider->eventMgr;
+        this->resources[provider->worldName] = resources;
+    }
+
+    startupTimer.toc("plugin loading");
+
+    return server;
+}
+
+bool GazeboSimulator::Impl::runServers(const bool paused,
+                                       const size_t iterations,
+                                       const bool deterministic)
+{
+    // A blocking run with zero iterations would never return
+    if (!paused && deterministic && iterations == 0) {
+        sError << "Blocking runs require a positive number of iterations"
+               << std::endl;
+        return false;
+    }
+
+    std::vector<detail::WorkerPool::Task> tasks;
+    tasks.reserve(servers.size());
+
+    for (const auto& server : servers) {
+        // Servers running in background are started only once
+        if (!paused && !deterministic && server->Running()) {
+            continue;
+        }
+
+        tasks.emplace_back([server, paused, iterations, deterministic]() {
+            return paused ? server->RunOnce(/*paused=*/true)
+                          : server->Run(/*blocking=*/deterministic,
+                                        /*iterations=*/iterations,
+                                        /*paused=*/false);
+        });
+    }
+
+    if (!parallel.pool->run(tasks)) {
+        sError << "The servers couldn't execute the "
+               << (paused ? "paused " : "") << "step" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+detail::WorkerPool::WorkerPool(const size_t numOfThreads)
+{
+    for (size_t i = 0; i < numOfThreads; ++i) {
+        threads.emplace_back(&WorkerPool::worker, this);
+    }
+}
+
+detail::WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard lock(mutex);
+        stop = true;
+    }
+
+    cvWork.notify_all();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool detail::WorkerPool::run(const std::vector<Task>& tasks)
+{
+    if (tasks.empty()) {
+        return true;
+    }
+
+    std::unique_lock lock(mutex);
+
+    this->tasks = &tasks;
+    this->nextTask = 0;
+    this->success = true;
+    this->pendingTasks = tasks.size();
+
+    cvWork.notify_all();
+    cvDone.wait(lock, [this] { return pendingTasks == 0; });
+
+    this->tasks = nullptr;
+    return this->success;
+}
+
+void detail::WorkerPool::worker()
+{
+    std::unique_lock lock(mutex);
+
+    while (true) {
+        cvWork.wait(lock, [this] {
+            return stop || (tasks && nextTask < tasks->size());
+        });
+
+        if (stop) {
+            return;
+        }
+
+        // Pick the next task and execute it without holding the lock
+        const Task& task = (*tasks)[nextTask++];
+        lock.unlock();
+        const bool ok = task();
+        lock.lock();
+
+        success = success && ok;
+
+        if (--pendingTasks == 0) {
+            cvDone.notify_one();
+        }
+    }
+}
+
 std::shared_ptr<World> GazeboSimulator::Impl::CreateGazeboWorld(
     const std::string& worldName,
     const detail::SimulationResources& resources)
@@ -28,13 +28,14 @@
 #include "scenario/gazebo/Log.h"
 #include "scenario/gazebo/Model.h"
 #include "scenario/gazebo/World.h"
-#include "scenario/gazebo/components/HistoryOfAppliedJointForces.h"
 #include "scenario/gazebo/components/JointAcceleration.h"
 #include "scenario/gazebo/components/JointAccelerationTarget.h"
 #include "scenario/gazebo/components/JointControlMode.h"
 #include "scenario/gazebo/components/JointController.h"
 #include "scenario/gazebo/components/JointControllerPeriod.h"
+#include "scenario/gazebo/components/JointHistory.h"
 #include "scenario/gazebo/components/JointPID.h"
+#include "scenario/gazebo/components/JointPIDBank.h"
 #include "scenario/gazebo/components/JointPositionTarget.h"
 #include "scenario/gazebo/components/JointVelocityTarget.h"
 #include "scenario/gazebo/components/Timestamp.h"
@@ -66,6 +67,20 @@ const ignition::math::PID DefaultPID(1, 0.1, 0.01, -1, 0, -1, 0, 0);
 class Joint::Impl
 {
 public:
+    // Invalidate the PID of the joint in the bank of the JointController of
+    // the parent model, if any. The other PIDs of the bank keep their state.
+    static void
+    invalidateJointPID(ignition::gazebo::EntityComponentManager* ecm,
+                       const ignition::gazebo::Entity jointEntity)
+    {
+        auto* bank =
+            ecm->Component<ignition::gazebo::components::JointPIDBank>(
+                ecm->ParentEntity(jointEntity));
+
+        if (bank) {
+            bank->Data().invalidate(jointEntity);
+        }
+    }
 };
 
 Joint::Joint()
@@ -154,12 +169,14 @@ bool Joint::resetPosition(const double position, size_t dof)
         jointPositionReset = std::vector<double>(this->dofs(), 0.0);
     }
 
-    // Reset the PID
+    // Reset the PID, also the one used by the JointController
     auto& pid = utils::getExistingComponentData< //
         ignition::gazebo::components::JointPID>(m_ecm, m_entity);
     pid.Reset();
+    Impl::invalidateJointPID(m_ecm, m_entity);
 
     jointPositionReset[dof] = position;
+    utils::enqueueJointCommand(m_ecm, m_entity);
     return true;
 }
 
@@ -179,12 +196,14 @@ bool Joint::resetVelocity(const double velocity, const size_t dof)
         jointVelocityReset = std::vector<double>(this->dofs(), 0.0);
     }
 
-    // Reset the PID
+    // Reset the PID, also the one used by the JointController
     auto& pid = utils::getExistingComponentData< //
         ignition::gazebo::components::JointPID>(m_ecm, m_entity);
     pid.Reset();
+    Impl::invalidateJointPID(m_ecm, m_entity);
 
     jointVelocityReset[dof] = velocity;
+    utils::enqueueJointCommand(m_ecm, m_entity);
     return true;
 }
 
@@ -218,11 +237,13 @@ bool Joint::resetJointPosition(const std::vector<double>& position)
 
     // Update the position
     jointPositionReset = position;
+    utils::enqueueJointCommand(m_ecm, m_entity);
 
-    // Reset the PID
+    // Reset the PID, also the one used by the JointController
     auto& pid = utils::getExistingComponentData< //
         ignition::gazebo::components::JointPID>(m_ecm, m_entity);
     pid.Reset();
+    Impl::invalidateJointPID(m_ecm, m_entity);
 
     return true;
 }
@@ -240,11 +261,13 @@ bool Joint::resetJointVelocity(const std::vector<double>& velocity)
 
     // Update the velocity
     jointVelocityReset = velocity;
+    utils::enqueueJointCommand(m_ecm, m_entity);
 
-    // Reset the PID
+    // Reset the PID, also the one used by the JointController
     auto& pid = utils::getExistingComponentData< //
         ignition::gazebo::components::JointPID>(m_ecm, m_entity);
     pid.Reset();
+    Impl::invalidateJointPID(m_ecm, m_entity);
 
     return true;
 }
@@ -377,14 +400,10 @@ scenario::core::JointControlMode Joint::controlMode() const
 
 bool Joint::setControlMode(const scenario::core::JointControlMode mode)
 {
-    if (mode == core::JointControlMode::PositionInterpolated) {
-        sError << "PositionInterpolated not yet supported" << std::endl;
-        return false;
-    }
-
     // Insert the JointController plugin to the model if the control
-    // mode is either Position or Velocity
+    // mode is actuated by it
     if (mode == core::JointControlMode::Position
+        || mode == core::JointControlMode::PositionInterpolated
         || mode == core::JointControlMode::Velocity
         || mode == core::JointControlMode::VelocityFollowerDart) {
 
@@ -465,6 +484,9 @@ bool Joint::setControlMode(const scenario::core::JointControlMode mode)
         ignition::gazebo::components::JointPID>(m_ecm, m_entity);
     pid.Reset();
 
+    // The JointController groups again the joints at its next update
+    Impl::invalidateJointPID(m_ecm, m_entity);
+
     return true;
 }
 
@@ -530,45 +552,80 @@ bool Joint::setPID(const scenario::core::PID& pid)
                                     ignition::math::PID>(
         m_ecm, m_entity, pidIgnitionMath, eqOp);
 
+    // The JointController loads the new PID at its next update
+    Impl::invalidateJointPID(m_ecm, m_entity);
+
     return true;
 }
 
 bool Joint::historyOfAppliedJointForcesEnabled() const
 {
-    return m_ecm->EntityHasComponentType(
-        m_entity,
-        ignition::gazebo::components::HistoryOfAppliedJointForces::typeId);
+    return this->historyEnabled(JointSignal::AppliedForce);
 }
 
 bool Joint::enableHistoryOfAppliedJointForces(const bool enable,
                                               const size_t maxHistorySize)
+{
+    return this->enableHistory(
+        JointSignal::AppliedForce, enable, maxHistorySize);
+}
+
+std::vector<double> Joint::historyOfAppliedJointForces() const
+{
+    return this->history(JointSignal::AppliedForce);
+}
+
+bool Joint::historyEnabled(const JointSignal signal) const
+{
+    auto* component =
+        m_ecm->Component<ignition::gazebo::components::JointHistory>(
+            m_entity);
+
+    return component && component->Data().enabled(signal);
+}
+
+bool Joint::enableHistory(const JointSignal signal,
+                          const bool enable,
+                          const size_t maxHistorySize)
 {
     if (enable) {
-        // If the component already exists, its value is not overridden
-        utils::getComponent<
-            ignition::gazebo::components::HistoryOfAppliedJointForces>(
-            m_ecm, m_entity, utils::FixedSizeQueue(maxHistorySize));
+        auto& history = utils::getComponentData< //
+            ignition::gazebo::components::JointHistory>(m_ecm, m_entity);
+
+        // If the history is already enabled, the stored values are kept
+        history.enable(signal, maxHistorySize, this->dofs());
+        return true;
     }
-    else {
+
+    auto* component =
+        m_ecm->Component<ignition::gazebo::components::JointHistory>(
+            m_entity);
+
+    if (!component) {
+        return true;
+    }
+
+    component->Data().disable(signal);
+
+    if (component->Data().empty()) {
         m_ecm->RemoveComponent(
-            m_entity,
-            ignition::gazebo::components::HistoryOfAppliedJointForces::typeId);
+            m_entity, ignition::gazebo::components::JointHistory::typeId);
     }
 
     return true;
 }
 
-std::vector<double> Joint::historyOfAppliedJointForces() const
+std::vector<double> Joint::history(const JointSignal signal) const
 {
-    if (!this->historyOfAppliedJointForcesEnabled()) {
+    auto* component =
+        m_ecm->Component<ignition::gazebo::components::JointHistory>(
+            m_entity);
+
+    if (!component || !component->Data().enabled(signal)) {
         return {};
     }
 
-    const auto& fixedSizeQueue = utils::getExistingComponentData<
-        ignition::gazebo::components::HistoryOfAppliedJointForces>(m_ecm,
-                                                                   m_entity);
-
-    return fixedSizeQueue.toStdVector();
+    return component->Data().buffer(signal)->toStdVector();
 }
 
 double Joint::coulombFriction() const
@@ -842,6 +899,7 @@ bool Joint::setGeneralizedForceTarget(const double force, const size_t dof)
 
     // Set the component data
     jointForce[dof] = force;
+    utils::enqueueJointCommand(m_ecm, m_entity);
 
     return true;
 }
@@ -1169,6 +1227,7 @@ bool Joint::setJointGeneralizedForceTarget(const std::vector<double>& force)
 
     // Set the component data
     jointForceTarget = force;
+    utils::enqueueJointCommand(m_ecm, m_entity);
     return true;
 }
 
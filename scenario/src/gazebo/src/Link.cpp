@@ -28,6 +28,9 @@
 #include "scenario/gazebo/Log.h"
 #include "scenario/gazebo/Model.h"
 #include "scenario/gazebo/World.h"
+#include "scenario/gazebo/components/ContactAccumulator.h"
+#include "scenario/gazebo/components/ContactBuffer.h"
+#include "scenario/gazebo/components/ContactFilter.h"
 #include "scenario/gazebo/components/ExternalWorldWrenchCmdWithDuration.h"
 #include "scenario/gazebo/components/SimulatedTime.h"
 #include "scenario/gazebo/exceptions.h"
@@ -39,22 +42,27 @@
 #include <ignition/gazebo/components/AngularVelocity.hh>
 #include <ignition/gazebo/components/CanonicalLink.hh>
 #include <ignition/gazebo/components/Collision.hh>
-#include <ignition/gazebo/components/ContactSensorData.hh>
 #include <ignition/gazebo/components/Inertial.hh>
 #include <ignition/gazebo/components/LinearAcceleration.hh>
 #include <ignition/gazebo/components/LinearVelocity.hh>
 #include <ignition/gazebo/components/Model.hh>
+#include <ignition/gazebo/components/Name.hh>
 #include <ignition/gazebo/components/ParentEntity.hh>
 #include <ignition/gazebo/components/Pose.hh>
+#include <ignition/gazebo/components/World.hh>
 #include <ignition/math/Inertial.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Quaternion.hh>
 #include <ignition/math/Vector3.hh>
-#include <ignition/msgs/contacts.pb.h>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <map>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 using namespace scenario::gazebo;
 
@@ -314,12 +322,12 @@ bool Link::contactsEnabled() const
 
     // Iterate through all link's collisions
     for (const auto collisionEntity : collisionEntities) {
-        const bool hasContactSensorData = m_ecm->EntityHasComponentType(
+        const bool hasContactBuffer = m_ecm->EntityHasComponentType(
             collisionEntity,
-            ignition::gazebo::components::ContactSensorData::typeId);
+            ignition::gazebo::components::ContactBuffer::typeId);
 
         // Return false if a collision does not have the contact data component
-        if (!hasContactSensorData) {
+        if (!hasContactBuffer) {
             return false;
         }
     }
@@ -337,12 +345,11 @@ bool Link::enableContactDetection(const bool enable)
             ignition::gazebo::components::Collision(),
             ignition::gazebo::components::ParentEntity(m_entity));
 
-        // Create the contact sensor data component that enables the Physics
+        // Create the contact buffer component that enables the Physics
         // system to extract contact information from the physics engine
         for (const auto collisionEntity : collisionEntities) {
-            m_ecm->CreateComponent(
-                collisionEntity,
-                ignition::gazebo::components::ContactSensorData());
+            m_ecm->CreateComponent(collisionEntity,
+                                   ignition::gazebo::components::ContactBuffer());
         }
 
         return true;
@@ -361,10 +368,9 @@ bool Link::enableContactDetection(const bool enable)
             return true;
         }
 
-        // Delete the contact sensor data component
+        // Delete the contact buffer component
         for (const auto collisionEntity : collisionEntities) {
-            m_ecm->RemoveComponent<
-                ignition::gazebo::components::ContactSensorData>(
+            m_ecm->RemoveComponent<ignition::gazebo::components::ContactBuffer>(
                 collisionEntity);
         }
 
@@ -373,6 +379,16 @@ bool Link::enableContactDetection(const bool enable)
             return false;
         }
 
+        // Remove the contact filter of the link, if any
+        const auto worldEntity = utils::getFirstParentEntityWithComponent<
+            ignition::gazebo::components::World>(m_ecm, m_entity);
+
+        if (auto* filter = m_ecm->Component<
+                ignition::gazebo::components::ContactFilter>(worldEntity);
+            filter && filter->Data()) {
+            filter->Data()->remove(m_entity);
+        }
+
         return true;
     }
 
@@ -396,6 +412,28 @@ std::vector<scenario::core::Contact> Link::contacts() const
         return {};
     }
 
+    // Get the scoped name of the link of a collision, that is resolved only
+    // once for each link in contact
+    std::unordered_map<ignition::gazebo::Entity, std::string> bodyNames;
+
+    auto getBodyName =
+        [&](const ignition::gazebo::Entity collision) -> const std::string& {
+        const auto linkEntity = m_ecm->ParentEntity(collision);
+        auto it = bodyNames.find(linkEntity);
+
+        if (it == bodyNames.end()) {
+            const auto modelEntity = m_ecm->ParentEntity(linkEntity);
+            const std::string& linkName = utils::getExistingComponentData<
+                ignition::gazebo::components::Name>(m_ecm, linkEntity);
+            const std::string& modelName = utils::getExistingComponentData<
+                ignition::gazebo::components::Name>(m_ecm, modelEntity);
+            it = bodyNames.emplace(linkEntity, modelName + "::" + linkName)
+                     .first;
+        }
+
+        return it->second;
+    };
+
     using BodyNameA = std::string;
     using BodyNameB = std::string;
     using CollisionsInContact = std::pair<BodyNameA, BodyNameB>;
@@ -403,44 +441,38 @@ std::vector<scenario::core::Contact> Link::contacts() const
 
     for (const auto collisionEntity : collisionEntities) {
 
-        // Skip collisions entities without contact sensor
-        if (!m_ecm->EntityHasComponentType(
-                collisionEntity,
-                ignition::gazebo::components::ContactSensorData::typeId)) {
+        // Skip collisions entities without contact buffer
+        const auto* contactBuffer =
+            m_ecm->Component<ignition::gazebo::components::ContactBuffer>(
+                collisionEntity);
+
+        if (!contactBuffer) {
             continue;
         }
 
-        // Get the contact data for the selected collision entity
-        const ignition::msgs::Contacts& contactSensorData =
-            utils::getExistingComponentData<
-                ignition::gazebo::components::ContactSensorData>(
-                m_ecm, collisionEntity);
-
-        // Convert the ignition msg
-        const std::vector<core::Contact>& collisionContacts =
-            utils::fromIgnitionContactsMsgs(m_ecm, contactSensorData);
+        // Read the contact points filled by the Physics system
+        for (const auto& point : contactBuffer->Data()) {
+            const std::string& bodyA = getBodyName(point.collision);
+            const std::string& bodyB = getBodyName(point.otherCollision);
 
-        for (const auto& contact : collisionContacts) {
-            assert(!contact.bodyA.empty());
-            assert(!contact.bodyB.empty());
+            // Get the entry containing the Contact object of the pair of
+            // bodies, creating it if needed
+            auto& contact = contactsMap[std::make_pair(bodyA, bodyB)];
 
-            // Create the key that collects the entry containing the
-            // Contact object of the pair of bodies
-            const auto key = std::make_pair(contact.bodyA, contact.bodyB);
+            if (contact.bodyA.empty()) {
+                contact.bodyA = bodyA;
+                contact.bodyB = bodyB;
+            }
 
-            if (contactsMap.find(key) != contactsMap.end()) {
-                // Get the existing contact object
-                auto& thisContact = contactsMap.at(key);
+            // The contact points extracted from the physics have no torque
+            core::ContactPoint contactPoint;
+            contactPoint.depth = point.depth;
+            contactPoint.force = point.force;
+            contactPoint.torque = {0, 0, 0};
+            contactPoint.normal = point.normal;
+            contactPoint.position = point.position;
 
-                // Insert the new points
-                thisContact.points.insert(thisContact.points.end(),
-                                          contact.points.begin(),
-                                          contact.points.end());
-            }
-            else {
-                // Create a new Contact
-                contactsMap[key] = contact;
-            }
+            contact.points.push_back(contactPoint);
         }
     }
 
@@ -578,3 +610,125 @@ bool Link::applyWorldWrenchToCoM(const std::array<double, 3>& force,
                                   utils::fromIgnitionVector(torqueIgnitionMath),
                                   duration);
 }
+
+bool Link::setContactFilter(const std::vector<std::string>& bodies)
+{
+    const auto world = utils::getParentWorld(*this);
+
+    if (!world) {
+        sError << "Failed to get the parent world of link '" << this->name()
+               << "'" << std::endl;
+        return false;
+    }
+
+    auto& filter = utils::getComponentData< //
+        ignition::gazebo::components::ContactFilter>(m_ecm, world->entity());
+
+    if (!filter) {
+        filter = std::make_shared<utils::ContactFilter>();
+    }
+
+    if (bodies.empty()) {
+        filter->remove(m_entity);
+        return true;
+    }
+
+    const std::vector<std::string> modelNames = world->modelNames();
+
+    auto hasModel = [&](const std::string& modelName) -> bool {
+        return std::find(modelNames.begin(), modelNames.end(), modelName)
+               != modelNames.end();
+    };
+
+    std::unordered_set<ignition::gazebo::Entity> allowed;
+
+    for (const auto& body : bodies) {
+        // The body is a model
+        if (hasModel(body)) {
+            const auto model =
+                std::static_pointer_cast<Model>(world->getModel(body));
+            allowed.insert(model->entity());
+            continue;
+        }
+
+        // The body is a link with its name scoped with the model name
+        const auto separator = body.rfind("::");
+
+        if (separator == std::string::npos
+            || !hasModel(body.substr(0, separator))) {
+            sError << "Failed to find body '" << body << "'" << std::endl;
+            return false;
+        }
+
+        const auto model = world->getModel(body.substr(0, separator));
+        const std::string linkName = body.substr(separator + 2);
+        const auto linkNames = model->linkNames();
+
+        if (std::find(linkNames.begin(), linkNames.end(), linkName)
+            == linkNames.end()) {
+            sError << "Failed to find body '" << body << "'" << std::endl;
+            return false;
+        }
+
+        const auto link =
+            std::static_pointer_cast<Link>(model->getLink(linkName));
+        allowed.insert(link->entity());
+    }
+
+    filter->set(m_entity, std::move(allowed));
+    return true;
+}
+
+bool Link::contactAccumulationEnabled() const
+{
+    return m_ecm->EntityHasComponentType(
+        m_entity, ignition::gazebo::components::ContactAccumulator::typeId);
+}
+
+bool Link::enableContactAccumulation(const bool enable)
+{
+    if (enable && !this->contactAccumulationEnabled()) {
+        // Contacts are accumulated from the contact points of the collisions
+        if (!this->enableContactDetection(true)) {
+            sError << "Failed to enable contact detection" << std::endl;
+            return false;
+        }
+
+        m_ecm->CreateComponent(
+            m_entity, ignition::gazebo::components::ContactAccumulator());
+    }
+
+    if (!enable && this->contactAccumulationEnabled()) {
+        m_ecm->RemoveComponent<
+            ignition::gazebo::components::ContactAccumulator>(m_entity);
+    }
+
+    return true;
+}
+
+ContactStatistics Link::contactStatistics() const
+{
+    if (!this->contactAccumulationEnabled()) {
+        throw exceptions::LinkError("Contact accumulation is not enabled",
+                                    this->name());
+    }
+
+    const auto& accumulator = utils::getExistingComponentData<
+        ignition::gazebo::components::ContactAccumulator>(m_ecm, m_entity);
+
+    ContactStatistics statistics;
+    statistics.steps = accumulator.steps;
+    statistics.stepsInContact = accumulator.stepsInContact;
+    statistics.numOfContactPoints = accumulator.points;
+    statistics.maxForce = accumulator.maxForce;
+    statistics.impulse = accumulator.impulse;
+
+    if (accumulator.steps > 0) {
+        for (size_t i = 0; i < 3; ++i) {
+            statistics.meanForce[i] =
+                accumulator.sumForce[i] / static_cast<double>(accumulator.steps);
+        }
+    }
+
+    return statistics;
+}
@@ -32,7 +32,11 @@
 #include "scenario/gazebo/components/BasePoseTarget.h"
 #include "scenario/gazebo/components/BaseWorldAccelerationTarget.h"
 #include "scenario/gazebo/components/BaseWorldVelocityTarget.h"
+#include "scenario/gazebo/components/ControllerTimingAccumulator.h"
 #include "scenario/gazebo/components/JointControllerPeriod.h"
+#include "scenario/gazebo/components/JointInterpolationDuration.h"
+#include "scenario/gazebo/components/JointStateCache.h"
+#include "scenario/gazebo/components/JointTrajectoryBuffer.h"
 #include "scenario/gazebo/components/Timestamp.h"
 #include "scenario/gazebo/exceptions.h"
 #include "scenario/gazebo/helpers.h"
@@ -60,6 +64,8 @@
 #include <cassert>
 #include <chrono>
 #include <functional>
+#include <iterator>
+#include <memory>
 #include <tuple>
 #include <unordered_map>
 
@@ -85,6 +91,32 @@ public:
         std::optional<std::vector<std::string>> scopedJointNames;
     } buffers;
 
+    std::shared_ptr<utils::JointStateCache> jointStateCache;
+
+    static const utils::JointStateCache*
+    getJointStateCache(const Model* model);
+
+    static const utils::JointTrajectoryBuffer&
+    getJointTrajectoryBuffer(const Model* model);
+
+    static std::vector<double> getRecordedData(
+        const Model* model,
+        const std::vector<double> utils::JointTrajectoryBuffer::*recordedData,
+        const size_t rowSize);
+
+    static std::vector<double> getJointDataSelected(
+        const Model* model,
+        const JointSelection& selection,
+        const std::vector<double> utils::JointStateCache::*cachedData,
+        std::function<double(core::JointPtr, const size_t)> getJointData);
+
+    static bool setJointDataSelected(
+        Model* model,
+        const std::vector<double>& data,
+        const JointSelection& selection,
+        std::function<bool(core::JointPtr, const double, const size_t)>
+            setDataToDOF);
+
     static std::vector<double> getJointDataSerialized(
         const Model* model,
         const std::vector<std::string>& jointNames,
@@ -174,6 +206,26 @@ bool Model::createECMResources()
         }
     }
 
+    // Create the contiguous cache of the joint state that is refreshed by
+    // the Physics system after each step
+    if (!m_ecm->EntityHasComponentType(
+            m_entity, ignition::gazebo::components::JointStateCache::typeId)) {
+        std::vector<ignition::gazebo::Entity> jointEntities;
+        std::vector<size_t> jointDofs;
+
+        for (const auto& joint : this->joints()) {
+            jointEntities.push_back(
+                std::static_pointer_cast<Joint>(joint)->entity());
+            jointDofs.push_back(joint->dofs());
+        }
+
+        m_ecm->CreateComponent(
+            m_entity,
+            ignition::gazebo::components::JointStateCache(
+                std::make_shared<utils::JointStateCache>(jointEntities,
+                                                         jointDofs)));
+    }
+
     if (!this->enableSelfCollisions(false)) {
         sError << "Failed to initialize disabled self collisions" << std::endl;
         return false;
@@ -552,10 +604,64 @@ bool Model::setControllerPeriod(const double period)
     return true;
 }
 
+double Model::interpolationDuration() const
+{
+    const auto* component = m_ecm->Component<
+        ignition::gazebo::components::JointInterpolationDuration>(m_entity);
+
+    if (!component) {
+        return 0.0;
+    }
+
+    return utils::steadyClockDurationToDouble(component->Data());
+}
+
+bool Model::setInterpolationDuration(const double duration)
+{
+    if (duration < 0) {
+        sError << "The interpolation duration cannot be negative" << std::endl;
+        return false;
+    }
+
+    // The default duration is used if the component is missing
+    if (duration == 0) {
+        m_ecm->RemoveComponent(
+            m_entity,
+            ignition::gazebo::components::JointInterpolationDuration::typeId);
+        return true;
+    }
+
+    utils::setComponentData<
+        ignition::gazebo::components::JointInterpolationDuration>(
+        m_ecm, m_entity, utils::doubleToSteadyClockDuration(duration));
+    return true;
+}
+
 bool Model::enableHistoryOfAppliedJointForces(
     const bool enable,
     const size_t maxHistorySizePerJoint,
     const std::vector<std::string>& jointNames)
+{
+    return this->enableHistory(
+        JointSignal::AppliedForce, enable, maxHistorySizePerJoint, jointNames);
+}
+
+bool Model::historyOfAppliedJointForcesEnabled(
+    const std::vector<std::string>& jointNames) const
+{
+    return this->historyEnabled(JointSignal::AppliedForce, jointNames);
+}
+
+std::vector<double> Model::historyOfAppliedJointForces(
+    const std::vector<std::string>& jointNames) const
+{
+    return this->history(JointSignal::AppliedForce, jointNames);
+}
+
+bool Model::enableHistory(const JointSignal signal,
+                          const bool enable,
+                          const size_t maxHistorySizePerJoint,
+                          const std::vector<std::string>& jointNames)
 {
     const std::vector<std::string>& jointSerialization =
         jointNames.empty() ? this->jointNames() : jointNames;
@@ -564,15 +670,15 @@ bool Model::enableHistoryOfAppliedJointForces(
 
     for (const auto& joint : this->joints(jointSerialization)) {
         ok = ok
-             && joint->enableHistoryOfAppliedJointForces(
-                 enable, maxHistorySizePerJoint);
+             && std::static_pointer_cast<Joint>(joint)->enableHistory(
+                 signal, enable, maxHistorySizePerJoint);
     }
 
     return ok;
 }
 
-bool Model::historyOfAppliedJointForcesEnabled(
-    const std::vector<std::string>& jointNames) const
+bool Model::historyEnabled(const JointSignal signal,
+                           const std::vector<std::string>& jointNames) const
 {
     const std::vector<std::string>& jointSerialization =
         jointNames.empty() ? this->jointNames() : jointNames;
@@ -580,46 +686,57 @@ bool Model::historyOfAppliedJointForcesEnabled(
     bool enabled = true;
 
     for (const auto& joint : this->joints(jointSerialization)) {
-        enabled = enabled && joint->historyOfAppliedJointForcesEnabled();
+        enabled = enabled
+                  && std::static_pointer_cast<Joint>(joint)->historyEnabled(
+                      signal);
     }
 
     return enabled;
 }
 
-std::vector<double> Model::historyOfAppliedJointForces(
-    const std::vector<std::string>& jointNames) const
+std::vector<double>
+Model::history(const JointSignal signal,
+               const std::vector<std::string>& jointNames) const
 {
     const std::vector<std::string>& jointSerialization =
         jointNames.empty() ? this->jointNames() : jointNames;
 
-    std::vector<double> history;
-    std::vector<double> allAppliedJointForces;
+    size_t historySize = 0;
+    std::vector<double> allJointsHistory;
 
     for (const auto& joint : this->joints(jointSerialization)) {
-        history = joint->historyOfAppliedJointForces();
-        std::move(history.begin(),
-                  history.end(),
-                  std::back_inserter(allAppliedJointForces));
+        const std::vector<double> history =
+            std::static_pointer_cast<Joint>(joint)->history(signal);
+
+        if (allJointsHistory.empty()) {
+            historySize = history.size();
+            allJointsHistory.reserve(jointSerialization.size() * historySize);
+        }
 
-        if (joint->name() == jointSerialization.front()) {
-            history.reserve(jointSerialization.size() * history.size());
+        if (history.size() != historySize) {
+            sError << "The history of joint '" << joint->name()
+                   << "' has a different size" << std::endl;
+            return {};
         }
+
+        allJointsHistory.insert(
+            allJointsHistory.end(), history.begin(), history.end());
     }
 
     // Given:
-    // * <j_1>: vector 1xH of torques of joint 1
-    // * <tau_t>: vector 1xn of torques of the considered joints at a given t
+    // * <j_1>: vector 1xH of values of joint 1
+    // * <v_t>: vector 1xn of values of the considered joints at a given t
     //
-    // We want to convert the allAppliedJointForces:
+    // We want to convert the allJointsHistory:
     // * From: <j_1><j_2>...<j_n>
-    // * To:   <tau_t-H>...<tau_t-2><tau_t-1><tau_t>
+    // * To:   <v_t-H>...<v_t-2><v_t-1><v_t>
     //
-    // In other words, we want that the torques applied at the last step are
-    // piled up in the end of the returned vector.
+    // In other words, we want that the values of the last step are piled up
+    // in the end of the returned vector.
     utils::rowMajorToColumnMajor(
-        allAppliedJointForces, jointSerialization.size(), history.size());
+        allJointsHistory, jointSerialization.size(), historySize);
 
-    return allAppliedJointForces;
+    return allJointsHistory;
 }
 
 bool Model::contactsEnabled() const
@@ -677,6 +794,387 @@ bool Model::enableSelfCollisions(const bool enable)
     return true;
 }
 
+bool Model::setContactFilter(const std::vector<std::string>& bodies)
+{
+    bool ok = true;
+
+    // Apply the filter to all the links also if one of them fails. The bodies
+    // are validated by each link before changing its filter.
+    for (auto& link : this->links()) {
+        ok = std::static_pointer_cast<Link>(link)->setContactFilter(bodies)
+             && ok;
+    }
+
+    if (!ok) {
+        sError << "Failed to set the contact filter of model '" << this->name()
+               << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool Model::enableContactAccumulation(const bool enable)
+{
+    bool ok = true;
+
+    for (auto& link : this->links()) {
+        ok = ok
+             && std::static_pointer_cast<Link>(link)->enableContactAccumulation(
+                 enable);
+    }
+
+    if (!ok) {
+        sError << "Failed to enable the contact accumulation of model '"
+               << this->name() << "'" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<ContactStatistics>
+Model::contactStatistics(const std::vector<std::string>& linkNames) const
+{
+    const std::vector<std::string>& linkSerialization =
+        linkNames.empty() ? this->linkNames() : linkNames;
+
+    std::vector<ContactStatistics> statistics;
+    statistics.reserve(linkSerialization.size());
+
+    for (const auto& linkName : linkSerialization) {
+        const auto link =
+            std::static_pointer_cast<Link>(this->getLink(linkName));
+        statistics.push_back(link->contactStatistics());
+    }
+
+    return statistics;
+}
+
+ControllerStatistics Model::controllerStatistics() const
+{
+    const auto* component = m_ecm->Component<
+        ignition::gazebo::components::ControllerTimingAccumulator>(m_entity);
+
+    if (!component) {
+        throw exceptions::ModelError("The model has no controller",
+                                     this->name());
+    }
+
+    const auto& timing = component->Data();
+
+    ControllerStatistics statistics;
+    statistics.steps = timing.steps;
+    statistics.overruns = timing.overruns;
+    statistics.minTime = timing.steps > 0 ? timing.minTime : 0.0;
+    statistics.meanTime = timing.meanTime();
+    statistics.p99Time = timing.percentile(0.99);
+    statistics.maxTime = timing.maxTime;
+
+    return statistics;
+}
+
+const double* Model::jointPositionsView() const
+{
+    const auto* cache = Impl::getJointStateCache(this);
+    return cache ? cache->positions.data() : nullptr;
+}
+
+const double* Model::jointVelocitiesView() const
+{
+    const auto* cache = Impl::getJointStateCache(this);
+    return cache ? cache->velocities.data() : nullptr;
+}
+
+const double* Model::jointAccelerationsView() const
+{
+    const auto* cache = Impl::getJointStateCache(this);
+    return cache ? cache->accelerations.data() : nullptr;
+}
+
+const double* Model::jointGeneralizedForcesView() const
+{
+    const auto* cache = Impl::getJointStateCache(this);
+    return cache ? cache->forces.data() : nullptr;
+}
+
+std::shared_ptr<const void> Model::jointStateCacheOwner() const
+{
+    Impl::getJointStateCache(this);
+    return pImpl->jointStateCache;
+}
+
+bool Model::enableTrajectoryRecording(const bool enable, const size_t capacity)
+{
+    if (!enable) {
+        m_ecm->RemoveComponent<
+            ignition::gazebo::components::JointTrajectoryBuffer>(m_entity);
+        return true;
+    }
+
+    if (capacity == 0) {
+        sError << "The capacity of the trajectory buffer must be positive"
+               << std::endl;
+        return false;
+    }
+
+    // Enabling the recording again discards the recorded data
+    utils::getComponentData<
+        ignition::gazebo::components::JointTrajectoryBuffer>(m_ecm, m_entity) =
+        utils::JointTrajectoryBuffer(capacity, this->dofs());
+
+    return true;
+}
+
+bool Model::trajectoryRecordingEnabled() const
+{
+    return m_ecm->EntityHasComponentType(
+        m_entity,
+        ignition::gazebo::components::JointTrajectoryBuffer::typeId);
+}
+
+size_t Model::numOfRecordedSteps() const
+{
+    return Impl::getJointTrajectoryBuffer(this).size;
+}
+
+std::vector<double> Model::recordedTimes() const
+{
+    return Impl::getRecordedData(
+        this, &utils::JointTrajectoryBuffer::times, 1);
+}
+
+std::vector<double> Model::recordedJointPositions() const
+{
+    return Impl::getRecordedData(
+        this, &utils::JointTrajectoryBuffer::positions, this->dofs());
+}
+
+std::vector<double> Model::recordedJointVelocities() const
+{
+    return Impl::getRecordedData(
+        this, &utils::JointTrajectoryBuffer::velocities, this->dofs());
+}
+
+std::vector<double> Model::recordedJointGeneralizedForces() const
+{
+    return Impl::getRecordedData(
+        this, &utils::JointTrajectoryBuffer::forces, this->dofs());
+}
+
+std::vector<double> Model::recordedBasePoses() const
+{
+    return Impl::getRecordedData(this,
+                                 &utils::JointTrajectoryBuffer::basePoses,
+                                 utils::JointTrajectoryBuffer::PoseSize);
+}
+
+JointSelection
+Model::jointSelection(const std::vector<std::string>& jointNames) const
+{
+    const std::vector<std::string>& jointSerialization =
+        jointNames.empty() ? this->jointNames() : jointNames;
+
+    JointSelection selection(m_entity);
+    selection.m_jointNames = jointSerialization;
+
+    for (const auto& joint : this->joints(jointSerialization)) {
+        selection.m_joints.push_back(joint);
+        selection.m_entities.push_back(
+            std::static_pointer_cast<Joint>(joint)->entity());
+        selection.m_offsets.push_back(selection.m_offsets.back()
+                                      + joint->dofs());
+    }
+
+    const auto* cache = Impl::getJointStateCache(this);
+
+    if (!cache) {
+        return selection;
+    }
+
+    // Map the selected DoFs to their indices in the joint state cache
+    std::vector<size_t> cacheIndices;
+    cacheIndices.reserve(selection.dofs());
+
+    for (const auto jointEntity : selection.m_entities) {
+        const auto it = std::find(
+            cache->joints.begin(), cache->joints.end(), jointEntity);
+
+        // Joints not part of the cache (e.g. without DoFs) prevent using it
+        if (it == cache->joints.end()) {
+            return selection;
+        }
+
+        const size_t j = std::distance(cache->joints.begin(), it);
+
+        for (size_t idx = cache->offsets[j]; idx < cache->offsets[j + 1];
+             ++idx) {
+            cacheIndices.push_back(idx);
+        }
+    }
+
+    selection.m_cacheIndices = std::move(cacheIndices);
+    return selection;
+}
+
+bool Model::resetJointPositions(const std::vector<double>& positions,
+                                const JointSelection& selection)
+{
+    auto lambda = [](core::JointPtr joint,
+                     const double position,
+                     const size_t dof) -> bool {
+        return std::static_pointer_cast<Joint>(joint)->resetPosition(position,
+                                                                     dof);
+    };
+
+    return Impl::setJointDataSelected(this, positions, selection, lambda);
+}
+
+bool Model::resetJointVelocities(const std::vector<double>& velocities,
+                                 const JointSelection& selection)
+{
+    auto lambda = [](core::JointPtr joint,
+                     const double velocity,
+                     const size_t dof) -> bool {
+        return std::static_pointer_cast<Joint>(joint)->resetVelocity(velocity,
+                                                                     dof);
+    };
+
+    return Impl::setJointDataSelected(this, velocities, selection, lambda);
+}
+
+std::vector<double>
+Model::jointPositions(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->position(dof);
+    };
+
+    return Impl::getJointDataSelected(
+        this, selection, &utils::JointStateCache::positions, lambda);
+}
+
+std::vector<double>
+Model::jointVelocities(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->velocity(dof);
+    };
+
+    return Impl::getJointDataSelected(
+        this, selection, &utils::JointStateCache::velocities, lambda);
+}
+
+std::vector<double>
+Model::jointAccelerations(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->acceleration(dof);
+    };
+
+    return Impl::getJointDataSelected(
+        this, selection, &utils::JointStateCache::accelerations, lambda);
+}
+
+std::vector<double>
+Model::jointGeneralizedForces(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->generalizedForce(dof);
+    };
+
+    return Impl::getJointDataSelected(
+        this, selection, &utils::JointStateCache::forces, lambda);
+}
+
+bool Model::setJointPositionTargets(const std::vector<double>& positions,
+                                    const JointSelection& selection)
+{
+    auto lambda = [](core::JointPtr joint,
+                     const double position,
+                     const size_t dof) -> bool {
+        return joint->setPositionTarget(position, dof);
+    };
+
+    return Impl::setJointDataSelected(this, positions, selection, lambda);
+}
+
+bool Model::setJointVelocityTargets(const std::vector<double>& velocities,
+                                    const JointSelection& selection)
+{
+    auto lambda = [](core::JointPtr joint,
+                     const double velocity,
+                     const size_t dof) -> bool {
+        return joint->setVelocityTarget(velocity, dof);
+    };
+
+    return Impl::setJointDataSelected(this, velocities, selection, lambda);
+}
+
+bool Model::setJointAccelerationTargets(
+    const std::vector<double>& accelerations,
+    const JointSelection& selection)
+{
+    auto lambda = [](core::JointPtr joint,
+                     const double acceleration,
+                     const size_t dof) -> bool {
+        return joint->setAccelerationTarget(acceleration, dof);
+    };
+
+    return Impl::setJointDataSelected(this, accelerations, selection, lambda);
+}
+
+bool Model::setJointGeneralizedForceTargets(const std::vector<double>& forces,
+                                            const JointSelection& selection)
+{
+    auto lambda =
+        [](core::JointPtr joint, const double force, const size_t dof) -> bool {
+        return joint->setGeneralizedForceTarget(force, dof);
+    };
+
+    return Impl::setJointDataSelected(this, forces, selection, lambda);
+}
+
+std::vector<double>
+Model::jointPositionTargets(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->positionTarget(dof);
+    };
+
+    return Impl::getJointDataSelected(this, selection, nullptr, lambda);
+}
+
+std::vector<double>
+Model::jointVelocityTargets(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->velocityTarget(dof);
+    };
+
+    return Impl::getJointDataSelected(this, selection, nullptr, lambda);
+}
+
+std::vector<double>
+Model::jointAccelerationTargets(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->accelerationTarget(dof);
+    };
+
+    return Impl::getJointDataSelected(this, selection, nullptr, lambda);
+}
+
+std::vector<double>
+Model::jointGeneralizedForceTargets(const JointSelection& selection) const
+{
+    auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
+        return joint->generalizedForceTarget(dof);
+    };
+
+    return Impl::getJointDataSelected(this, selection, nullptr, lambda);
+}
+
 std::vector<std::string> Model::linksInContact() const
 {
     pImpl->buffers.linksInContact.clear();
@@ -711,6 +1209,15 @@ Model::contacts(const std::vector<std::string>& linkNames) const
 std::vector<double>
 Model::jointPositions(const std::vector<std::string>& jointNames) const
 {
+    // Serve the default serialization from the contiguous cache
+    if (jointNames.empty()) {
+        const auto* cache = Impl::getJointStateCache(this);
+
+        if (cache && cache->populated) {
+            return cache->positions;
+        }
+    }
+
     auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
         return joint->position(dof);
     };
@@ -721,6 +1228,15 @@ Model::jointPositions(const std::vector<std::string>& jointNames) const
 std::vector<double>
 Model::jointVelocities(const std::vector<std::string>& jointNames) const
 {
+    // Serve the default serialization from the contiguous cache
+    if (jointNames.empty()) {
+        const auto* cache = Impl::getJointStateCache(this);
+
+        if (cache && cache->populated) {
+            return cache->velocities;
+        }
+    }
+
     auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
         return joint->velocity(dof);
     };
@@ -731,6 +1247,15 @@ Model::jointVelocities(const std::vector<std::string>& jointNames) const
 std::vector<double>
 Model::jointAccelerations(const std::vector<std::string>& jointNames) const
 {
+    // Serve the default serialization from the contiguous cache
+    if (jointNames.empty()) {
+        const auto* cache = Impl::getJointStateCache(this);
+
+        if (cache && cache->populated) {
+            return cache->accelerations;
+        }
+    }
+
     auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
         return joint->acceleration(dof);
     };
@@ -741,6 +1266,15 @@ Model::jointAccelerations(const std::vector<std::string>& jointNames) const
 std::vector<double>
 Model::jointGeneralizedForces(const std::vector<std::string>& jointNames) const
 {
+    // Serve the default serialization from the contiguous cache
+    if (jointNames.empty()) {
+        const auto* cache = Impl::getJointStateCache(this);
+
+        if (cache && cache->populated) {
+            return cache->forces;
+        }
+    }
+
     auto lambda = [](core::JointPtr joint, const size_t dof) -> double {
         return joint->generalizedForce(dof);
     };
@@ -1201,6 +1735,24 @@ std::array<double, 3> Model::baseWorldAngularAccelerationTarget() const
 // Implementation Methods
 // ======================
 
+const utils::JointStateCache*
+Model::Impl::getJointStateCache(const Model* model)
+{
+    if (!model->pImpl->jointStateCache) {
+        auto* component = model->m_ecm->Component<
+            ignition::gazebo::components::JointStateCache>(model->m_entity);
+
+        if (!component || !component->Data()) {
+            return nullptr;
+        }
+
+        // Keep a reference to the shared buffers
+        model->pImpl->jointStateCache = component->Data();
+    }
+
+    return model->pImpl->jointStateCache.get();
+}
+
 std::vector<double> Model::Impl::getJointDataSerialized(
     const Model* model,
     const std::vector<std::string>& jointNames,
@@ -1228,20 +1780,13 @@ bool Model::Impl::setJointDataSerialized(
     std::function<bool(core::JointPtr, const double, const size_t)>
         setJointData)
 {
-    std::vector<std::string> jointSerialization;
+    // Resolve the joints only once
+    const std::vector<core::JointPtr> joints = model->joints(jointNames);
 
     size_t expectedDOFs = 0;
 
-    if (!jointNames.empty()) {
-        jointSerialization = jointNames;
-
-        for (auto& joint : model->joints(jointSerialization)) {
-            expectedDOFs += joint->dofs();
-        }
-    }
-    else {
-        expectedDOFs = model->dofs();
-        jointSerialization = model->jointNames();
+    for (const auto& joint : joints) {
+        expectedDOFs += joint->dofs();
     }
 
     if (data.size() != expectedDOFs) {
@@ -1253,7 +1798,7 @@ bool Model::Impl::setJointDataSerialized(
 
     auto it = data.begin();
 
-    for (auto& joint : model->joints(jointNames)) {
+    for (auto& joint : joints) {
         for (size_t dof = 0; dof < joint->dofs(); ++dof) {
             if (!setJointData(joint, *it++, dof)) {
                 sError << "Failed to set force of joint '" << joint->name()
@@ -1265,3 +1810,104 @@ bool Model::Impl::setJointDataSerialized(
     assert(it == data.end());
     return true;
 }
+
+const utils::JointTrajectoryBuffer&
+Model::Impl::getJointTrajectoryBuffer(const Model* model)
+{
+    if (!model->trajectoryRecordingEnabled()) {
+        throw exceptions::ModelError("Trajectory recording is not enabled",
+                                     model->name());
+    }
+
+    return utils::getExistingComponentData<
+        ignition::gazebo::components::JointTrajectoryBuffer>(model->m_ecm,
+                                                             model->m_entity);
+}
+
+std::vector<double> Model::Impl::getRecordedData(
+    const Model* model,
+    const std::vector<double> utils::JointTrajectoryBuffer::*recordedData,
+    const size_t rowSize)
+{
+    const auto& buffer = Impl::getJointTrajectoryBuffer(model);
+    return buffer.linearize(buffer.*recordedData, rowSize);
+}
+
+std::vector<double> Model::Impl::getJointDataSelected(
+    const Model* model,
+    const JointSelection& selection,
+    const std::vector<double> utils::JointStateCache::*cachedData,
+    std::function<double(core::JointPtr, const size_t)> getJointData)
+{
+    if (selection.modelEntity() != model->m_entity) {
+        throw exceptions::ModelError(
+            "The joint selection was created by a different model",
+            model->name());
+    }
+
+    const auto* cache = Impl::getJointStateCache(model);
+
+    // Gather the data from the contiguous cache, if possible
+    if (cachedData && cache && cache->populated
+        && selection.m_cacheIndices.size() == selection.dofs()) {
+        const std::vector<double>& source = cache->*cachedData;
+
+        std::vector<double> data(selection.dofs());
+
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = source[selection.m_cacheIndices[i]];
+        }
+
+        return data;
+    }
+
+    std::vector<double> data;
+    data.reserve(selection.dofs());
+
+    for (size_t j = 0; j < selection.m_joints.size(); ++j) {
+        const size_t jointDofs =
+            selection.m_offsets[j + 1] - selection.m_offsets[j];
+
+        for (size_t dof = 0; dof < jointDofs; ++dof) {
+            data.push_back(getJointData(selection.m_joints[j], dof));
+        }
+    }
+
+    return data;
+}
+
+bool Model::Impl::setJointDataSelected(
+    Model* model,
+    const std::vector<double>& data,
+    const JointSelection& selection,
+    std::function<bool(core::JointPtr, const double, const size_t)>
+        setJointData)
+{
+    if (selection.modelEntity() != model->m_entity) {
+        sError << "The joint selection was created by a different model"
+               << std::endl;
+        return false;
+    }
+
+    if (data.size() != selection.dofs()) {
+        sError << "The size of the data does not match the DoFs of the "
+                  "joint selection"
+               << std::endl;
+        return false;
+    }
+
+    for (size_t j = 0; j < selection.m_joints.size(); ++j) {
+        const size_t offset = selection.m_offsets[j];
+        const size_t jointDofs = selection.m_offsets[j + 1] - offset;
+
+        for (size_t dof = 0; dof < jointDofs; ++dof) {
+            if (!setJointData(selection.m_joints[j], data[offset + dof], dof)) {
+                sError << "Failed to set data of joint '"
+                       << selection.m_joints[j]->name() << "'" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
@@ -27,6 +27,19 @@
 #include "scenario/gazebo/World.h"
 #include "scenario/gazebo/Log.h"
 #include "scenario/gazebo/Model.h"
+#include "scenario/gazebo/components/BasePoseTarget.h"
+#include "scenario/gazebo/components/BaseWorldAccelerationTarget.h"
+#include "scenario/gazebo/components/BaseWorldVelocityTarget.h"
+#include "scenario/gazebo/components/ExternalWorldWrenchCmdWithDuration.h"
+#include "scenario/gazebo/components/JointAccelerationTarget.h"
+#include "scenario/gazebo/components/JointCommandQueue.h"
+#include "scenario/gazebo/components/JointControlMode.h"
+#include "scenario/gazebo/components/JointPID.h"
+#include "scenario/gazebo/components/JointPIDBank.h"
+#include "scenario/gazebo/components/JointPositionTarget.h"
+#include "scenario/gazebo/components/JointStateCache.h"
+#include "scenario/gazebo/components/JointVelocityTarget.h"
+#include "scenario/gazebo/components/ModelRegistry.h"
 #include "scenario/gazebo/components/SimulatedTime.h"
 #include "scenario/gazebo/components/Timestamp.h"
 #include "scenario/gazebo/exceptions.h"
@@ -36,13 +49,31 @@
 #include <ignition/common/Event.hh>
 #include <ignition/gazebo/Events.hh>
 #include <ignition/gazebo/SdfEntityCreator.hh>
+#include <ignition/gazebo/components/AngularVelocity.hh>
+#include <ignition/gazebo/components/AngularVelocityCmd.hh>
+#include <ignition/gazebo/components/CanonicalLink.hh>
 #include <ignition/gazebo/components/Gravity.hh>
+#include <ignition/gazebo/components/Joint.hh>
+#include <ignition/gazebo/components/JointForceCmd.hh>
+#include <ignition/gazebo/components/JointPosition.hh>
+#include <ignition/gazebo/components/JointPositionReset.hh>
+#include <ignition/gazebo/components/JointVelocity.hh>
+#include <ignition/gazebo/components/JointVelocityCmd.hh>
+#include <ignition/gazebo/components/JointVelocityReset.hh>
+#include <ignition/gazebo/components/LinearVelocity.hh>
+#include <ignition/gazebo/components/LinearVelocityCmd.hh>
+#include <ignition/gazebo/components/Link.hh>
 #include <ignition/gazebo/components/Model.hh>
 #include <ignition/gazebo/components/Name.hh>
 #include <ignition/gazebo/components/ParentEntity.hh>
 #include <ignition/gazebo/components/Physics.hh>
 #include <ignition/gazebo/components/PhysicsEnginePlugin.hh>
 #include <ignition/gazebo/components/Pose.hh>
+#include <ignition/gazebo/components/PoseCmd.hh>
+#include <ignition/gazebo/components/WorldAngularVelocity.hh>
+#include <ignition/gazebo/components/WorldLinearVelocity.hh>
+#include <ignition/gazebo/components/WorldPose.hh>
+#include <ignition/math/PID.hh>
 #include <ignition/math/Pose3.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/physics/config.hh>
@@ -53,7 +84,9 @@
 #include <algorithm>
 #include <cassert>
 #include <functional>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
 
 using namespace scenario::gazebo;
 
@@ -65,43 +98,120 @@ public:
     using ModelName = std::string;
     std::unordered_map<ModelName, core::ModelPtr> models;
 
+    // Registry of the models of the world, if maintained by the simulator.
+    // When missing, the models are found by scanning the ECM.
+    std::shared_ptr<utils::ModelRegistry> modelRegistry;
+    utils::ModelRegistry* getModelRegistry(const World& world);
+    ignition::gazebo::Entity getModelEntity(const std::string& modelName,
+                                            const World& world);
+
     struct
     {
         std::vector<std::string> modelNames;
     } buffers;
 
+    struct JointState
+    {
+        ignition::gazebo::Entity entity;
+        std::vector<double> position;
+        std::vector<double> velocity;
+        std::optional<ignition::math::PID> pid;
+        std::optional<core::JointControlMode> controlMode;
+        std::optional<std::vector<double>> positionTarget;
+        std::optional<std::vector<double>> velocityTarget;
+        std::optional<std::vector<double>> accelerationTarget;
+        std::optional<std::vector<double>> forceCmd;
+        std::optional<std::vector<double>> velocityCmd;
+    };
+
+    struct LinkState
+    {
+        ignition::gazebo::Entity entity;
+        std::optional<ignition::math::Pose3d> pose;
+        std::optional<ignition::math::Pose3d> worldPose;
+        std::optional<ignition::math::Vector3d> linearVelocity;
+        std::optional<ignition::math::Vector3d> angularVelocity;
+        std::optional<ignition::math::Vector3d> worldLinearVelocity;
+        std::optional<ignition::math::Vector3d> worldAngularVelocity;
+        std::optional<utils::LinkWrenchCmd> wrenchCmd;
+    };
+
+    struct ModelState
+    {
+        ignition::gazebo::Entity entity;
+        ignition::math::Pose3d pose;
+        ignition::gazebo::Entity canonicalLink;
+        // Velocity of the canonical link expressed in the world frame
+        ignition::math::Vector3d baseWorldLinearVelocity;
+        ignition::math::Vector3d baseWorldAngularVelocity;
+        std::optional<ignition::math::Pose3d> basePoseTarget;
+        std::optional<ignition::math::Vector3d> baseLinearVelocityTarget;
+        std::optional<ignition::math::Vector3d> baseAngularVelocityTarget;
+        std::optional<ignition::math::Vector3d> baseLinearAccelerationTarget;
+        std::optional<ignition::math::Vector3d> baseAngularAccelerationTarget;
+        std::optional<utils::JointStateCache> jointStateCache;
+        std::optional<utils::JointPIDBank> jointPIDBank;
+        std::vector<JointState> joints;
+        std::vector<LinkState> links;
+    };
+
+    using WorldState = std::vector<ModelState>;
+
+    uint64_t nextStateHandle = 0;
+    std::unordered_map<uint64_t, WorldState> states;
+
+    template <typename ComponentTypeT, typename DataTypeT>
+    static void saveComponentData(ignition::gazebo::EntityComponentManager* ecm,
+                                  const ignition::gazebo::Entity entity,
+                                  std::optional<DataTypeT>& data)
+    {
+        if (const auto* component = ecm->Component<ComponentTypeT>(entity)) {
+            data = component->Data();
+        }
+    }
+
+    template <typename ComponentTypeT, typename DataTypeT>
+    static void
+    restoreComponentData(ignition::gazebo::EntityComponentManager* ecm,
+                         const ignition::gazebo::Entity entity,
+                         const std::optional<DataTypeT>& data)
+    {
+        if (data) {
+            utils::getComponentData<ComponentTypeT>(ecm, entity) = *data;
+            ecm->SetChanged(entity,
+                            ComponentTypeT::typeId,
+                            ignition::gazebo::ComponentState::OneTimeChange);
+        }
+    }
+
+    static ModelState
+    saveModelState(ignition::gazebo::EntityComponentManager* ecm,
+                   const ignition::gazebo::Entity modelEntity);
+
+    static bool
+    restoreModelState(ignition::gazebo::EntityComponentManager* ecm,
+                      const ModelState& state);
+
 public:
-    bool insertModel(const std::shared_ptr<sdf::Root>& modelSdfRoot,
-                     const core::Pose& pose,
-                     const std::string& overrideModelName,
-                     World& world)
+    static std::string
+    getModelName(const std::shared_ptr<sdf::Root>& modelSdfRoot,
+                 const std::string& overrideModelName)
     {
         // NOTE: sdf::Root objects could only contain one sdf::Model starting
         //       from sdformat11.
-
-        // Name of the model to insert (allowing renaming from SDF)
-        std::string finalModelEntityName;
-
-        // Get the final name of the model
-        if (overrideModelName.empty()) {
-            assert(modelSdfRoot->Model());
-            finalModelEntityName = modelSdfRoot->Model()->Name();
-        }
-        else {
-            finalModelEntityName = overrideModelName;
+        if (!overrideModelName.empty()) {
+            return overrideModelName;
         }
 
-        // Check for model name clash
-        const std::vector<std::string>& modelNames = world.modelNames();
-        if (std::find(
-                modelNames.begin(), modelNames.end(), finalModelEntityName)
-            != modelNames.end()) {
-            sError << "Failed to insert model '" << finalModelEntityName
-                   << "'. Another entity with the same name already exists."
-                   << std::endl;
-            return false;
-        }
+        assert(modelSdfRoot->Model());
+        return modelSdfRoot->Model()->Name();
+    }
 
+    ignition::gazebo::Entity
+    createModelEntity(const std::shared_ptr<sdf::Root>& modelSdfRoot,
+                      const std::string& finalModelEntityName,
+                      World& world)
+    {
         // Rename the model.
         // NOTE: The following is not enough because the name is not serialized
         //       to string. We need also to operate directly on the raw element.
@@ -114,7 +224,7 @@ public:
         // sdf name.
         if (!utils::renameSDFModel(*modelSdfRoot, finalModelEntityName)) {
             sError << "Failed to rename SDF model" << std::endl;
-            return false;
+            return ignition::gazebo::kNullEntity;
         }
 
         if (utils::verboseFromEnvironment()) {
@@ -129,6 +239,16 @@ public:
         // Attach the model entity to the world entity
         this->sdfEntityCreator->SetParent(modelEntity, world.m_entity);
 
+        // Plugins of the model could write joint commands directly in the ECM
+        if (utils::hasJointCommandWriters(modelSdfRoot->Element())) {
+            utils::setExternalJointCommandWriters(world.m_ecm, world.m_entity);
+        }
+
+        // Register the model so that it can be found before the next step
+        if (auto* registry = this->getModelRegistry(world)) {
+            registry->add(finalModelEntityName, modelEntity);
+        }
+
         {
             // Check that the model name is correct
             std::string modelNameSDF = modelSdfRoot->Model()->Name();
@@ -137,6 +257,14 @@ public:
             assert(modelNameSDF == modelNameEntity);
         }
 
+        return modelEntity;
+    }
+
+    bool initializeModel(const ignition::gazebo::Entity modelEntity,
+                         const core::Pose& pose,
+                         const std::string& finalModelEntityName,
+                         World& world)
+    {
         // Create the model
         auto model = std::make_shared<scenario::gazebo::Model>();
 
@@ -170,8 +298,324 @@ public:
 
         return true;
     }
+
+    bool insertModel(const std::shared_ptr<sdf::Root>& modelSdfRoot,
+                     const core::Pose& pose,
+                     const std::string& overrideModelName,
+                     World& world)
+    {
+        // Name of the model to insert (allowing renaming from SDF)
+        const std::string finalModelEntityName =
+            getModelName(modelSdfRoot, overrideModelName);
+
+        // Check for model name clash
+        if (this->getModelEntity(finalModelEntityName, world)
+            != ignition::gazebo::kNullEntity) {
+            sError << "Failed to insert model '" << finalModelEntityName
+                   << "'. Another entity with the same name already exists."
+                   << std::endl;
+            return false;
+        }
+
+        const auto modelEntity =
+            this->createModelEntity(modelSdfRoot, finalModelEntityName, world);
+
+        if (modelEntity == ignition::gazebo::kNullEntity) {
+            return false;
+        }
+
+        return this->initializeModel(
+            modelEntity, pose, finalModelEntityName, world);
+    }
 };
 
+utils::ModelRegistry* World::Impl::getModelRegistry(const World& world)
+{
+    if (!this->modelRegistry) {
+        if (const auto* component = world.m_ecm->Component< //
+                ignition::gazebo::components::ModelRegistry>(world.m_entity)) {
+            this->modelRegistry = component->Data();
+        }
+    }
+
+    return this->modelRegistry.get();
+}
+
+ignition::gazebo::Entity
+World::Impl::getModelEntity(const std::string& modelName, const World& world)
+{
+    if (const auto* registry = this->getModelRegistry(world)) {
+        return registry->entity(modelName);
+    }
+
+    return world.m_ecm->EntityByComponents(
+        ignition::gazebo::components::Name(modelName),
+        ignition::gazebo::components::Model(),
+        ignition::gazebo::components::ParentEntity(world.m_entity));
+}
+
+World::Impl::ModelState
+World::Impl::saveModelState(ignition::gazebo::EntityComponentManager* ecm,
+                            const ignition::gazebo::Entity modelEntity)
+{
+    ModelState state;
+    state.entity = modelEntity;
+    state.pose = utils::getExistingComponentData< //
+        ignition::gazebo::components::Pose>(ecm, modelEntity);
+
+    using namespace ignition::gazebo::components;
+    saveComponentData<BasePoseTarget>(ecm, modelEntity, state.basePoseTarget);
+    saveComponentData<BaseWorldLinearVelocityTarget>(
+        ecm, modelEntity, state.baseLinearVelocityTarget);
+    saveComponentData<BaseWorldAngularVelocityTarget>(
+        ecm, modelEntity, state.baseAngularVelocityTarget);
+    saveComponentData<BaseWorldLinearAccelerationTarget>(
+        ecm, modelEntity, state.baseLinearAccelerationTarget);
+    saveComponentData<BaseWorldAngularAccelerationTarget>(
+        ecm, modelEntity, state.baseAngularAccelerationTarget);
+
+    // The velocity of the model is the velocity of its canonical link.
+    // The Physics system stores it in the body frame of the link, and it is
+    // saved in the world frame so that it does not depend on the link pose.
+    state.canonicalLink = ecm->EntityByComponents(
+        ignition::gazebo::components::Link(),
+        ignition::gazebo::components::CanonicalLink(),
+        ignition::gazebo::components::ParentEntity(modelEntity));
+
+    if (state.canonicalLink != ignition::gazebo::kNullEntity) {
+        const auto& M_H_L = utils::getExistingComponentData< //
+            ignition::gazebo::components::Pose>(ecm, state.canonicalLink);
+        const auto W_R_L = state.pose.Rot() * M_H_L.Rot();
+
+        state.baseWorldLinearVelocity =
+            W_R_L
+            * utils::getComponentData< //
+                ignition::gazebo::components::LinearVelocity>(
+                ecm, state.canonicalLink);
+        state.baseWorldAngularVelocity =
+            W_R_L
+            * utils::getComponentData< //
+                ignition::gazebo::components::AngularVelocity>(
+                ecm, state.canonicalLink);
+    }
+
+    if (const auto* cache =
+            ecm->Component<ignition::gazebo::components::JointStateCache>(
+                modelEntity);
+        cache && cache->Data()) {
+        state.jointStateCache = *cache->Data();
+    }
+
+    saveComponentData<ignition::gazebo::components::JointPIDBank>(
+        ecm, modelEntity, state.jointPIDBank);
+
+    ecm->Each<ignition::gazebo::components::Joint,
+              ignition::gazebo::components::ParentEntity>(
+        [&](const ignition::gazebo::Entity& entity,
+            ignition::gazebo::components::Joint*,
+            ignition::gazebo::components::ParentEntity* parent) -> bool {
+            if (parent->Data() != modelEntity) {
+                return true;
+            }
+
+            JointState joint;
+            joint.entity = entity;
+            joint.position = utils::getComponentData< //
+                ignition::gazebo::components::JointPosition>(ecm, entity);
+            joint.velocity = utils::getComponentData< //
+                ignition::gazebo::components::JointVelocity>(ecm, entity);
+
+            saveComponentData<JointPID>(ecm, entity, joint.pid);
+            saveComponentData<JointControlMode>(ecm, entity, joint.controlMode);
+            saveComponentData<JointPositionTarget>(
+                ecm, entity, joint.positionTarget);
+            saveComponentData<JointVelocityTarget>(
+                ecm, entity, joint.velocityTarget);
+            saveComponentData<JointAccelerationTarget>(
+                ecm, entity, joint.accelerationTarget);
+            saveComponentData<JointForceCmd>(ecm, entity, joint.forceCmd);
+            saveComponentData<JointVelocityCmd>(
+                ecm, entity, joint.velocityCmd);
+
+            state.joints.push_back(std::move(joint));
+            return true;
+        });
+
+    ecm->Each<ignition::gazebo::components::Link,
+              ignition::gazebo::components::ParentEntity>(
+        [&](const ignition::gazebo::Entity& entity,
+            ignition::gazebo::components::Link*,
+            ignition::gazebo::components::ParentEntity* parent) -> bool {
+            if (parent->Data() != modelEntity) {
+                return true;
+            }
+
+            LinkState link;
+            link.entity = entity;
+
+            saveComponentData<Pose>(ecm, entity, link.pose);
+            saveComponentData<WorldPose>(ecm, entity, link.worldPose);
+            saveComponentData<LinearVelocity>(ecm, entity, link.linearVelocity);
+            saveComponentData<AngularVelocity>(
+                ecm, entity, link.angularVelocity);
+            saveComponentData<WorldLinearVelocity>(
+                ecm, entity, link.worldLinearVelocity);
+            saveComponentData<WorldAngularVelocity>(
+                ecm, entity, link.worldAngularVelocity);
+            saveComponentData<ExternalWorldWrenchCmdWithDuration>(
+                ecm, entity, link.wrenchCmd);
+
+            state.links.push_back(std::move(link));
+            return true;
+        });
+
+    return state;
+}
+
+bool World::Impl::restoreModelState(
+    ignition::gazebo::EntityComponentManager* ecm,
+    const ModelState& state)
+{
+    if (!ecm->HasEntity(state.entity)
+        || !ecm->EntityHasComponentType(
+            state.entity, ignition::gazebo::components::Model::typeId)) {
+        sError << "Model entity [" << state.entity << "] no longer exists"
+               << std::endl;
+        return false;
+    }
+
+    using namespace ignition::gazebo::components;
+
+    // Override the Pose component to have instantaneous effect, and store
+    // the command processed by the Physics system
+    utils::setExistingComponentData<Pose>(ecm, state.entity, state.pose);
+    utils::setComponentData<WorldPoseCmd>(ecm, state.entity, state.pose);
+
+    // The Physics system processes the velocity commands of the model in the
+    // frame of the model, using the restored pose
+    if (state.canonicalLink != ignition::gazebo::kNullEntity) {
+        utils::setComponentData<LinearVelocityCmd>(
+            ecm,
+            state.entity,
+            state.pose.Rot().RotateVectorReverse(
+                state.baseWorldLinearVelocity));
+        utils::setComponentData<AngularVelocityCmd>(
+            ecm,
+            state.entity,
+            state.pose.Rot().RotateVectorReverse(
+                state.baseWorldAngularVelocity));
+    }
+
+    restoreComponentData<BasePoseTarget>(
+        ecm, state.entity, state.basePoseTarget);
+    restoreComponentData<BaseWorldLinearVelocityTarget>(
+        ecm, state.entity, state.baseLinearVelocityTarget);
+    restoreComponentData<BaseWorldAngularVelocityTarget>(
+        ecm, state.entity, state.baseAngularVelocityTarget);
+    restoreComponentData<BaseWorldLinearAccelerationTarget>(
+        ecm, state.entity, state.baseLinearAccelerationTarget);
+    restoreComponentData<BaseWorldAngularAccelerationTarget>(
+        ecm, state.entity, state.baseAngularAccelerationTarget);
+
+    for (const auto& joint : state.joints) {
+        utils::setComponentData<JointPosition>(
+            ecm, joint.entity, joint.position);
+        utils::setComponentData<JointVelocity>(
+            ecm, joint.entity, joint.velocity);
+        utils::setComponentData<JointPositionReset>(
+            ecm, joint.entity, joint.position);
+        utils::setComponentData<JointVelocityReset>(
+            ecm, joint.entity, joint.velocity);
+
+        // The state of the integrators is restored with the PID bank
+        restoreComponentData<JointPID>(ecm, joint.entity, joint.pid);
+        restoreComponentData<JointControlMode>(
+            ecm, joint.entity, joint.controlMode);
+        restoreComponentData<JointPositionTarget>(
+            ecm, joint.entity, joint.positionTarget);
+        restoreComponentData<JointVelocityTarget>(
+            ecm, joint.entity, joint.velocityTarget);
+        restoreComponentData<JointAccelerationTarget>(
+            ecm, joint.entity, joint.accelerationTarget);
+        restoreComponentData<JointForceCmd>(ecm, joint.entity, joint.forceCmd);
+        restoreComponentData<JointVelocityCmd>(
+            ecm, joint.entity, joint.velocityCmd);
+
+        // The resets are applied by the Physics system only to queued joints
+        utils::enqueueJointCommand(ecm, joint.entity);
+    }
+
+    // Remove the wrenches applied after the state was saved
+    ecm->Each<ignition::gazebo::components::Link,
+              ParentEntity,
+              ExternalWorldWrenchCmdWithDuration>(
+        [&](const ignition::gazebo::Entity&,
+            ignition::gazebo::components::Link*,
+            ParentEntity* parent,
+            ExternalWorldWrenchCmdWithDuration* wrenchCmd) -> bool {
+            if (parent->Data() == state.entity) {
+                wrenchCmd->Data() = {};
+            }
+            return true;
+        });
+
+    // Override the kinematics of the links to have instantaneous effect. The
+    // Physics system updates them after the next step from the restored
+    // state of the model and its joints.
+    for (const auto& link : state.links) {
+        restoreComponentData<Pose>(ecm, link.entity, link.pose);
+        restoreComponentData<WorldPose>(ecm, link.entity, link.worldPose);
+        restoreComponentData<LinearVelocity>(
+            ecm, link.entity, link.linearVelocity);
+        restoreComponentData<AngularVelocity>(
+            ecm, link.entity, link.angularVelocity);
+        restoreComponentData<WorldLinearVelocity>(
+            ecm, link.entity, link.worldLinearVelocity);
+        restoreComponentData<WorldAngularVelocity>(
+            ecm, link.entity, link.worldAngularVelocity);
+        restoreComponentData<ExternalWorldWrenchCmdWithDuration>(
+            ecm, link.entity, link.wrenchCmd);
+    }
+
+    // Restore the PIDs of the JointController. If the bank did not exist when
+    // the state was saved, it is rebuilt from the restored JointPID components.
+    if (state.jointPIDBank) {
+        restoreComponentData<JointPIDBank>(
+            ecm, state.entity, state.jointPIDBank);
+    }
+    else if (auto* bank = ecm->Component<JointPIDBank>(state.entity)) {
+        bank->Data().clear();
+    }
+
+    // Copy the state in the existing cache so that its buffers do not move
+    if (state.jointStateCache) {
+        if (auto* cache = ecm->Component<JointStateCache>(state.entity);
+            cache && cache->Data()
+            && cache->Data()->dofs() == state.jointStateCache->dofs()) {
+            auto& target = *cache->Data();
+            const auto& source = *state.jointStateCache;
+
+            std::copy(source.positions.begin(),
+                      source.positions.end(),
+                      target.positions.begin());
+            std::copy(source.velocities.begin(),
+                      source.velocities.end(),
+                      target.velocities.begin());
+            std::copy(source.accelerations.begin(),
+                      source.accelerations.end(),
+                      target.accelerations.begin());
+            std::copy(source.forces.begin(),
+                      source.forces.end(),
+                      target.forces.begin());
+
+            target.populated = source.populated;
+            target.iteration = source.iteration;
+        }
+    }
+
+    return true;
+}
+
 World::World()
     : pImpl{std::make_unique<Impl>()}
 {}
@@ -248,8 +692,14 @@ bool World::insertWorldPlugin(const std::string& libName,
         *this, libName, className, context);
 }
 
-bool World::setPhysicsEngine(const PhysicsEngine engine)
+bool World::setPhysicsEngine(const PhysicsEngine engine, const size_t substeps)
 {
+    if (substeps == 0) {
+        sError << "The number of physics substeps must be positive"
+               << std::endl;
+        return false;
+    }
+
     // Get the name of the physics plugin
     const std::string pluginLib = [&engine]() -> std::string {
         switch (engine) {
@@ -270,12 +720,29 @@ bool World::setPhysicsEngine(const PhysicsEngine engine)
     utils::setComponentData<ignition::gazebo::components::PhysicsEnginePlugin>(
         m_ecm, m_entity, pluginLib);
 
+    // Joints with pending commands are enqueued by the scenario APIs, so that
+    // the Physics system does not have to process all the passive joints.
+    // The queue could already exist if systems writing directly in the ECM
+    // were inserted before the physics engine.
+    auto& queue = utils::getComponentData< //
+        ignition::gazebo::components::JointCommandQueue>(m_ecm, m_entity);
+
+    if (!queue) {
+        queue = std::make_shared<utils::JointCommandQueue>();
+    }
+
     // Vendored Physics system
     const std::string libName = "PhysicsSystem";
     const std::string className = "scenario::plugins::gazebo::Physics";
 
+    // Optional context of the Physics system
+    const std::string context =
+        substeps == 1 ? ""
+                      : "<sdf version='1.7'><substeps>"
+                            + std::to_string(substeps) + "</substeps></sdf>";
+
     // Load the Physics system
-    if (!this->insertWorldPlugin(libName, className)) {
+    if (!this->insertWorldPlugin(libName, className, context)) {
         sError << "Failed to insert the physics plugin" << std::endl;
         return false;
     }
@@ -334,6 +801,10 @@ std::string World::name() const
 
 std::vector<std::string> World::modelNames() const
 {
+    if (const auto* registry = pImpl->getModelRegistry(*this)) {
+        return registry->names();
+    }
+
     pImpl->buffers.modelNames.clear();
 
     m_ecm->Each<ignition::gazebo::components::Name,
@@ -367,10 +838,7 @@ scenario::core::ModelPtr World::getModel(const std::string& modelName) const
     }
 
     // Find the model entity
-    const auto modelEntity = m_ecm->EntityByComponents(
-        ignition::gazebo::components::Name(modelName),
-        ignition::gazebo::components::Model(),
-        ignition::gazebo::components::ParentEntity(m_entity));
+    const auto modelEntity = pImpl->getModelEntity(modelName, *this);
 
     if (modelEntity == ignition::gazebo::kNullEntity) {
         throw exceptions::ModelNotFound(modelName);
@@ -435,12 +903,113 @@ bool World::insertModelFromString(const std::string& sdfString,
         modelSdfRoot, pose, overrideModelName, *this);
 }
 
+bool World::insertModels(const std::vector<ModelSpec>& models)
+{
+    // Parse each source only once. The models are loaded from clones of the
+    // parsed elements, that retain the path of the file used to resolve the
+    // relative URIs of the resources. The two maps are indexed by
+    // ModelSpec::sourceIsString.
+    std::unordered_map<std::string, std::shared_ptr<sdf::Root>> sdfSources[2];
+
+    for (const auto& spec : models) {
+        auto& cache = sdfSources[spec.sourceIsString];
+
+        if (cache.find(spec.source) != cache.end()) {
+            continue;
+        }
+
+        const auto sdfRoot = spec.sourceIsString
+                                 ? utils::getSdfRootFromString(spec.source)
+                                 : utils::getSdfRootFromFile(spec.source);
+
+        if (!sdfRoot) {
+            // Error printed in the function call
+            return false;
+        }
+
+        cache[spec.source] = sdfRoot;
+    }
+
+    // Create a sdf::Root for each model and check the names before inserting
+    std::vector<std::string> modelNames;
+    std::vector<std::shared_ptr<sdf::Root>> sdfRoots;
+    std::unordered_set<std::string> uniqueNames;
+
+    modelNames.reserve(models.size());
+    sdfRoots.reserve(models.size());
+
+    for (const auto& spec : models) {
+        const auto sdfRoot = utils::getSdfRootFromElement(
+            sdfSources[spec.sourceIsString].at(spec.source)->Element());
+
+        if (!sdfRoot || !sdfRoot->Model()) {
+            sError << "Failed to load the model from the source" << std::endl;
+            return false;
+        }
+
+        const std::string modelName = Impl::getModelName(sdfRoot, spec.name);
+
+        if (!uniqueNames.insert(modelName).second
+            || pImpl->getModelEntity(modelName, *this)
+                   != ignition::gazebo::kNullEntity) {
+            sError << "Failed to insert model '" << modelName
+                   << "'. Another entity with the same name already exists."
+                   << std::endl;
+            return false;
+        }
+
+        sdfRoots.push_back(sdfRoot);
+        modelNames.push_back(modelName);
+    }
+
+    // Create all the entities
+    std::vector<ignition::gazebo::Entity> modelEntities;
+    modelEntities.reserve(models.size());
+
+    // If the batch fails midway, the models already created are removed so
+    // that either all or none of the models are inserted
+    auto removeCreatedModels = [&]() {
+        for (size_t i = 0; i < modelEntities.size(); ++i) {
+            if (!this->removeModel(modelNames[i])) {
+                sError << "Failed to remove model '" << modelNames[i]
+                       << "' after the failure" << std::endl;
+            }
+
+            if (auto* registry = pImpl->getModelRegistry(*this)) {
+                registry->remove(modelEntities[i]);
+            }
+        }
+    };
+
+    for (size_t i = 0; i < models.size(); ++i) {
+        const auto modelEntity =
+            pImpl->createModelEntity(sdfRoots[i], modelNames[i], *this);
+
+        if (modelEntity == ignition::gazebo::kNullEntity) {
+            removeCreatedModels();
+            return false;
+        }
+
+        modelEntities.push_back(modelEntity);
+    }
+
+    // Initialize the resources of all the models
+    for (size_t i = 0; i < models.size(); ++i) {
+        if (!pImpl->initializeModel(
+                modelEntities[i], models[i].pose, modelNames[i], *this)) {
+            sError << "Failed to insert model '" << modelNames[i] << "'"
+                   << std::endl;
+            removeCreatedModels();
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool World::removeModel(const std::string& modelName)
 {
-    const auto modelEntity = m_ecm->EntityByComponents(
-        ignition::gazebo::components::Name(modelName),
-        ignition::gazebo::components::Model(),
-        ignition::gazebo::components::ParentEntity(m_entity));
+    const auto modelEntity = pImpl->getModelEntity(modelName, *this);
 
     if (modelEntity == ignition::gazebo::kNullEntity) {
         sError << "Model '" << modelName << "' not found in the world"
@@ -458,3 +1027,46 @@ bool World::removeModel(const std::string& modelName)
 
     return true;
 }
+
+uint64_t World::saveState()
+{
+    Impl::WorldState state;
+
+    for (const auto& modelName : this->modelNames()) {
+        const auto modelEntity = pImpl->getModelEntity(modelName, *this);
+        state.push_back(Impl::saveModelState(m_ecm, modelEntity));
+    }
+
+    const uint64_t handle = pImpl->nextStateHandle++;
+    pImpl->states[handle] = std::move(state);
+
+    return handle;
+}
+
+bool World::restoreState(const uint64_t handle)
+{
+    if (pImpl->states.find(handle) == pImpl->states.end()) {
+        sError << "Failed to find the saved state #" << handle << std::endl;
+        return false;
+    }
+
+    for (const auto& modelState : pImpl->states.at(handle)) {
+        if (!Impl::restoreModelState(m_ecm, modelState)) {
+            sError << "Failed to restore the saved state #" << handle
+                   << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool World::removeState(const uint64_t handle)
+{
+    if (pImpl->states.erase(handle) == 0) {
+        sError << "Failed to find the saved state #" << handle << std::endl;
+        return false;
+    }
+
+    return true;
+}
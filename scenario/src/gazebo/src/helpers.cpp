@@ -27,6 +27,7 @@
 #include "scenario/gazebo/helpers.h"
 #include "ignition/common/Util.hh"
 #include "scenario/gazebo/Log.h"
+#include "scenario/gazebo/components/JointCommandQueue.h"
 #include "scenario/gazebo/components/Timestamp.h"
 
 #include <Eigen/Dense>
@@ -35,19 +36,166 @@
 #include <ignition/gazebo/components/Name.hh>
 #include <ignition/gazebo/components/World.hh>
 #include <ignition/msgs/contact.pb.h>
+#include <sdf/Element.hh>
 #include <sdf/Error.hh>
 #include <sdf/Model.hh>
 #include <sdf/Physics.hh>
+#include <sdf/SDFImpl.hh>
 #include <sdf/World.hh>
 
 #include <cassert>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
 #include <sstream>
+#include <system_error>
 
 using namespace scenario::gazebo;
 
+struct utils::SdfCache::Entry
+{
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size = 0;
+    sdf::ElementPtr element;
+};
+
+namespace {
+    struct SdfFileKey
+    {
+        std::string path;
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t size = 0;
+    };
+
+    // Files that do not exist in the filesystem (e.g. resolved from the
+    // resource paths by sdformat) are not cached
+    std::optional<SdfFileKey> getSdfFileKey(const std::string& fileName)
+    {
+        std::error_code ec;
+        const auto path = std::filesystem::absolute(fileName, ec);
+
+        if (ec || !std::filesystem::is_regular_file(path, ec)) {
+            return {};
+        }
+
+        SdfFileKey key;
+        key.path = path.lexically_normal().string();
+        key.mtime = std::filesystem::last_write_time(path, ec);
+        key.size = std::filesystem::file_size(path, ec);
+
+        if (ec) {
+            return {};
+        }
+
+        return key;
+    }
+} // namespace
+
+utils::SdfCache& utils::SdfCache::Instance()
+{
+    static SdfCache cache;
+    return cache;
+}
+
+std::shared_ptr<sdf::Root> utils::SdfCache::get(const std::string& fileName)
+{
+    const auto key = getSdfFileKey(fileName);
+
+    if (!key) {
+        return nullptr;
+    }
+
+    std::shared_ptr<Entry> entry;
+
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = m_entries.find(key->path);
+
+        // Drop the entry if the file changed
+        if (it != m_entries.end()
+            && (it->second->mtime != key->mtime
+                || it->second->size != key->size)) {
+            m_entries.erase(it);
+            it = m_entries.end();
+        }
+
+        if (it == m_entries.end()) {
+            m_stats.misses++;
+            return nullptr;
+        }
+
+        m_stats.hits++;
+        entry = it->second;
+    }
+
+    // Load a new root from a clone of the cached elements
+    auto root = getSdfRootFromElement(entry->element);
+
+    if (!root) {
+        sError << "Failed to load cached sdf file " << fileName << std::endl;
+        this->evict(fileName);
+        return nullptr;
+    }
+
+    return root;
+}
+
+void utils::SdfCache::insert(const std::string& fileName,
+                             const sdf::Root& root)
+{
+    const auto key = getSdfFileKey(fileName);
+
+    if (!key || !root.Element()) {
+        return;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->mtime = key->mtime;
+    entry->size = key->size;
+    entry->element = root.Element()->Clone();
+
+    std::lock_guard lock(m_mutex);
+    m_entries[key->path] = entry;
+}
+
+bool utils::SdfCache::evict(const std::string& fileName)
+{
+    std::error_code ec;
+    const auto path = std::filesystem::absolute(fileName, ec);
+
+    if (ec) {
+        return false;
+    }
+
+    std::lock_guard lock(m_mutex);
+    return m_entries.erase(path.lexically_normal().string()) > 0;
+}
+
+void utils::SdfCache::clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_entries.clear();
+    m_stats = {};
+}
+
+utils::SdfCacheStats utils::SdfCache::stats() const
+{
+    std::lock_guard lock(m_mutex);
+
+    SdfCacheStats stats = m_stats;
+    stats.entries = m_entries.size();
+
+    return stats;
+}
+
 std::shared_ptr<sdf::Root>
 utils::getSdfRootFromFile(const std::string& sdfFileName)
 {
+    // Serve the file from the cache if it was already loaded
+    if (auto root = SdfCache::Instance().get(sdfFileName)) {
+        return root;
+    }
+
     // NOTE: there's a double free error if we use std::optional
     // auto root = std::make_optional<sdf::Root>();
 
@@ -63,6 +211,7 @@ utils::getSdfRootFromFile(const std::string& sdfFileName)
         return {};
     }
 
+    SdfCache::Instance().insert(sdfFileName, *root);
     return root;
 }
 
@@ -87,6 +236,31 @@ utils::getSdfRootFromString(const std::string& sdfString)
     return root;
 }
 
+std::shared_ptr<sdf::Root>
+utils::getSdfRootFromElement(const sdf::ElementPtr& element)
+{
+    if (!element) {
+        return {};
+    }
+
+    auto sdf = std::make_shared<sdf::SDF>();
+    sdf->Root(element->Clone());
+
+    auto root = std::make_shared<sdf::Root>();
+    auto errors = root->Load(sdf);
+
+    if (!errors.empty()) {
+        sError << "Failed to load sdf element" << std::endl;
+
+        for (const auto& error : errors) {
+            sError << error << std::endl;
+        }
+        return {};
+    }
+
+    return root;
+}
+
 bool utils::verboseFromEnvironment()
 {
     std::string envVarContent;
@@ -589,3 +763,91 @@ std::shared_ptr<Model> utils::getParentModel(const GazeboEntity& gazeboEntity)
 
     return model;
 }
+
+void utils::enqueueJointCommand(ignition::gazebo::EntityComponentManager* ecm,
+                                const ignition::gazebo::Entity jointEntity)
+{
+    auto worldEntity = getFirstParentEntityWithComponent< //
+        ignition::gazebo::components::World>(ecm, jointEntity);
+
+    if (worldEntity == ignition::gazebo::kNullEntity) {
+        return;
+    }
+
+    // Worlds without the queue process the commands of all the joints
+    auto queueComponent = ecm->Component< //
+        ignition::gazebo::components::JointCommandQueue>(worldEntity);
+
+    if (!queueComponent || !queueComponent->Data()) {
+        return;
+    }
+
+    queueComponent->Data()->push(jointEntity);
+}
+
+void utils::setExternalJointCommandWriters(
+    ignition::gazebo::EntityComponentManager* ecm,
+    const ignition::gazebo::Entity entity)
+{
+    auto worldEntity = getFirstParentEntityWithComponent< //
+        ignition::gazebo::components::World>(ecm, entity);
+
+    if (worldEntity == ignition::gazebo::kNullEntity) {
+        return;
+    }
+
+    // The queue could be created later by World::setPhysicsEngine, which
+    // preserves the existing one
+    auto& queue = utils::getComponentData< //
+        ignition::gazebo::components::JointCommandQueue>(ecm, worldEntity);
+
+    if (!queue) {
+        queue = std::make_shared<utils::JointCommandQueue>();
+    }
+
+    queue->setExternalWriters(true);
+}
+
+bool utils::writesJointCommands(const std::string& className)
+{
+    // The scenario systems enqueue the joints they command
+    if (className.rfind("scenario::", 0) == 0) {
+        return false;
+    }
+
+    // Upstream systems that are known to never command the joints
+    static const std::unordered_set<std::string> readOnlySystems = {
+        "ignition::gazebo::systems::Contact",
+        "ignition::gazebo::systems::ForceTorque",
+        "ignition::gazebo::systems::Imu",
+        "ignition::gazebo::systems::JointStatePublisher",
+        "ignition::gazebo::systems::LogRecord",
+        "ignition::gazebo::systems::PosePublisher",
+        "ignition::gazebo::systems::SceneBroadcaster",
+        "ignition::gazebo::systems::Sensors",
+        "ignition::gazebo::systems::UserCommands",
+    };
+
+    return readOnlySystems.find(className) == readOnlySystems.end();
+}
+
+bool utils::hasJointCommandWriters(const sdf::ElementPtr& element)
+{
+    if (!element) {
+        return false;
+    }
+
+    if (element->GetName() == "plugin" && element->HasAttribute("name")
+        && writesJointCommands(element->Get<std::string>("name"))) {
+        return true;
+    }
+
+    for (auto child = element->GetFirstElement(); child;
+         child = child->GetNextElement()) {
+        if (hasJointCommandWriters(child)) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -422,5 +422,27 @@ bool utils::insertPluginToGazeboEntity(const GazeboEntity& gazeboEntity,
     gazeboEntity.eventManager()->Emit<ignition::gazebo::events::LoadPlugins>(
         gazeboEntity.entity(), wrapped);
 
+    // Systems outside scenario write the joint commands directly in the ECM,
+    // bypassing the queue processed by the Physics system
+    if (utils::writesJointCommands(className)) {
+        utils::setExternalJointCommandWriters(gazeboEntity.ecm(),
+                                              gazeboEntity.entity());
+    }
+
     return true;
 }
+
+utils::SdfCacheStats utils::sdfCacheStats()
+{
+    return SdfCache::Instance().stats();
+}
+
+bool utils::evictSdfCache(const std::string& fileName)
+{
+    return SdfCache::Instance().evict(fileName);
+}
+
+void utils::clearSdfCache()
+{
+    SdfCache::Instance().clear();
+}
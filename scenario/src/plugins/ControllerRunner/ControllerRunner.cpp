@@ -34,6 +34,7 @@
 #include "scenario/gazebo/components/BasePoseTarget.h"
 #include "scenario/gazebo/components/BaseWorldAccelerationTarget.h"
 #include "scenario/gazebo/components/BaseWorldVelocityTarget.h"
+#include "scenario/gazebo/components/ControllerTimingAccumulator.h"
 #include "scenario/gazebo/exceptions.h"
 #include "scenario/gazebo/helpers.h"
 
@@ -46,8 +47,11 @@
 #include <array>
 #include <cassert>
 #include <chrono>
+#include <iomanip>
+#include <iostream>
 #include <limits>
 #include <ratio>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -68,6 +72,15 @@ public:
     controllers::BaseReferences baseReferences;
     controllers::JointReferences jointReferences;
 
+    // Execution times of the controller. They are stored in the component of
+    // the model only by the first ControllerRunner of the model, and they are
+    // accumulated here only to be printed on destruction, when the ECM is no
+    // longer available.
+    utils::ControllerTimingAccumulator timing;
+    bool recordStatistics = false;
+    bool printStatistics = false;
+    std::string modelName;
+
     struct
     {
         controllers::SetBaseReferences* base = nullptr;
@@ -86,6 +99,8 @@ public:
 
     void printControllerContext(
         const std::shared_ptr<const sdf::Element> context) const;
+
+    void printTimingStatistics() const;
 };
 
 ControllerRunner::ControllerRunner()
@@ -97,7 +112,12 @@ ControllerRunner::ControllerRunner()
 //       unloaded when the model is removed.
 //       All model plugins are deleted when the simulator is destroyed,
 //       and there's no more ECM -> we would get segfault.
-ControllerRunner::~ControllerRunner() = default;
+ControllerRunner::~ControllerRunner()
+{
+    if (pImpl->printStatistics) {
+        pImpl->printTimingStatistics();
+    }
+}
 
 void ControllerRunner::Configure(const ignition::gazebo::Entity& entity,
                                  const std::shared_ptr<const sdf::Element>& sdf,
@@ -142,8 +162,17 @@ void ControllerRunner::Configure(const ignition::gazebo::Entity& entity,
         if (utils::verboseFromEnvironment()) {
             pImpl->printControllerContext(pluginElement);
         }
+
+        // Print the timing statistics when the plugin is destroyed
+        if (controllerContext->HasElement("print_statistics")) {
+            const auto value = controllerContext->Get<std::string>( //
+                "print_statistics");
+            pImpl->printStatistics = (value == "true" || value == "1");
+        }
     }
 
+    pImpl->modelName = pImpl->model->name();
+
     pImpl->controller =
         ControllersFactory::Instance().get(controllerContext, pImpl->model);
 
@@ -170,13 +199,30 @@ void ControllerRunner::Configure(const ignition::gazebo::Entity& entity,
     // Controller classes could inherit from various interfaces that specify the
     // accepted references. This design allows developing generic controllers.
     // Here we check if the controller inherits from the supported interfaces.
+    // Controllers that only read the model state, like policies, do not
+    // accept references.
     if (!(pImpl->controllerInterfaces.base
-          || pImpl->controllerInterfaces.joints)) {
+          || pImpl->controllerInterfaces.joints
+          || pImpl->controllerInterfaces.useModel)) {
         sWarning << "Failed to find any of the supported interfaces to set "
                  << "controller references" << std::endl;
         return;
     }
 
+    // The statistics of the model refer to its first ControllerRunner
+    if (ecm.EntityHasComponentType(
+            entity,
+            ignition::gazebo::components::ControllerTimingAccumulator::
+                typeId)) {
+        sWarning << "The model already has a ControllerRunner. Its statistics "
+                 << "will not include this controller." << std::endl;
+    }
+    else {
+        ecm.CreateComponent(
+            entity, ignition::gazebo::components::ControllerTimingAccumulator());
+        pImpl->recordStatistics = true;
+    }
+
     sDebug << "Controller successfully initialized" << std::endl;
 }
 
@@ -207,6 +253,9 @@ void ControllerRunner::PreUpdate(const ignition::gazebo::UpdateInfo& info,
 
     using namespace std::chrono;
 
+    // Start measuring the execution time of the controller
+    const auto stepStart = steady_clock::now();
+
     // Update the controller only if enough time is passed
     duration<double> elapsedFromLastUpdate =
         info.simTime - pImpl->prevUpdateTime;
@@ -274,11 +323,30 @@ void ControllerRunner::PreUpdate(const ignition::gazebo::UpdateInfo& info,
         pImpl->referencesHaveBeenSet = true;
     }
 
+    if (!pImpl->referencesHaveBeenSet) {
+        return;
+    }
+
     // Step the controller
-    if (pImpl->referencesHaveBeenSet && !pImpl->controller->step(info.dt)) {
+    if (!pImpl->controller->step(info.dt)) {
         sError << "Failed to step the controller" << std::endl;
         return;
     }
+
+    // Store the execution time of the controller
+    const duration<double> stepDuration = steady_clock::now() - stepStart;
+    const double period = pImpl->model->controllerPeriod();
+
+    if (pImpl->recordStatistics) {
+        utils::getExistingComponentData< //
+            ignition::gazebo::components::ControllerTimingAccumulator>(
+            &ecm, pImpl->modelEntity)
+            .add(stepDuration.count(), period);
+    }
+
+    if (pImpl->printStatistics) {
+        pImpl->timing.add(stepDuration.count(), period);
+    }
 }
 
 bool ControllerRunner::Impl::updateAllSupportedReferences(
@@ -390,6 +458,31 @@ void ControllerRunner::Impl::printControllerContext(
     std::cout << context->ToString("") << std::endl;
 }
 
+void ControllerRunner::Impl::printTimingStatistics() const
+{
+    const auto toMicroseconds = [](const double seconds) {
+        return seconds * 1e6;
+    };
+
+    std::ostringstream stream;
+    stream << "Controller statistics of model '" << modelName << "'"
+           << std::endl
+           << std::fixed << std::setprecision(3) //
+           << "  steps:    " << timing.steps << std::endl
+           << "  overruns: " << timing.overruns << std::endl
+           << "  min:      "
+           << toMicroseconds(timing.steps > 0 ? timing.minTime : 0.0) << " us"
+           << std::endl
+           << "  mean:     " << toMicroseconds(timing.meanTime()) << " us"
+           << std::endl
+           << "  p99:      " << toMicroseconds(timing.percentile(0.99))
+           << " us" << std::endl
+           << "  max:      " << toMicroseconds(timing.maxTime) << " us"
+           << std::endl;
+
+    std::cout << stream.str();
+}
+
 IGNITION_ADD_PLUGIN(
     scenario::plugins::gazebo::ControllerRunner,
     scenario::plugins::gazebo::ControllerRunner::System,
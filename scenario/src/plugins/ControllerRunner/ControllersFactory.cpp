@@ -26,6 +26,7 @@
 
 #include "ControllersFactory.h"
 #include "scenario/controllers/ComputedTorqueFixedBase.h"
+#include "scenario/controllers/MLPPolicy.h"
 #include "scenario/gazebo/Log.h"
 
 #include <sdf/Param.hh>
@@ -50,6 +51,8 @@ public:
     static T GetElementValueAs(const std::string& elementName,
                                const sdf::ElementPtr parentContext);
 
+    static void StringToStd(const std::string& string, double& out);
+
     static void StringToStd(const std::string& string,
                             std::vector<double>& out);
 
@@ -110,6 +113,20 @@ ControllersFactory::get(const sdf::ElementPtr context, core::ModelPtr model)
             return nullptr;
         }
 
+        // Optional recomputation periods of the dynamics quantities
+        double massMatrixPeriod = 0.0;
+        double biasForcesPeriod = 0.0;
+
+        if (context->HasElement("mass_matrix_period")) {
+            massMatrixPeriod = Impl::GetElementValueAs<double>(
+                "mass_matrix_period", context);
+        }
+
+        if (context->HasElement("bias_forces_period")) {
+            biasForcesPeriod = Impl::GetElementValueAs<double>(
+                "bias_forces_period", context);
+        }
+
         auto controller =
             std::make_shared<controllers::ComputedTorqueFixedBase>(
                 urdf,
@@ -117,7 +134,65 @@ ControllersFactory::get(const sdf::ElementPtr context, core::ModelPtr model)
                 kp,
                 kd,
                 joints,
-                std::array<double, 3>{gravity[0], gravity[1], gravity[2]});
+                std::array<double, 3>{gravity[0], gravity[1], gravity[2]},
+                massMatrixPeriod,
+                biasForcesPeriod);
+
+        return controller;
+    }
+
+    if (controllerName == "MLPPolicy") {
+
+        if (!context->HasElement("weights")) {
+            sError << "Controller context has missing elements" << std::endl;
+            return nullptr;
+        }
+
+        auto weights = Impl::GetElementValueAs<std::string>("weights", context);
+
+        std::vector<std::string> joints;
+        std::string output = "torque";
+        std::string baseObservation = "false";
+
+        if (context->HasElement("joints")) {
+            joints = Impl::GetElementValueAs< //
+                std::vector<std::string>>("joints", context);
+        }
+
+        if (context->HasElement("output")) {
+            output = Impl::GetElementValueAs<std::string>("output", context);
+        }
+
+        if (context->HasElement("base_observation")) {
+            baseObservation = Impl::GetElementValueAs<std::string>(
+                "base_observation", context);
+        }
+
+        if (output != "torque" && output != "position") {
+            sError << "Output '" << output << "' not recognized. "
+                   << "Use 'torque' or 'position'" << std::endl;
+            return nullptr;
+        }
+
+        // Optional normalization of the observation and the action
+        auto getOptionalVector = [&context](const std::string& name) {
+            return context->HasElement(name)
+                       ? Impl::GetElementValueAs< //
+                           std::vector<double>>(name, context)
+                       : std::vector<double>{};
+        };
+
+        auto controller = std::make_shared<controllers::MLPPolicy>(
+            weights,
+            model,
+            joints,
+            output == "torque" ? controllers::MLPPolicy::Output::Torque
+                               : controllers::MLPPolicy::Output::Position,
+            baseObservation == "true" || baseObservation == "1",
+            getOptionalVector("observation_offset"),
+            getOptionalVector("observation_scale"),
+            getOptionalVector("action_offset"),
+            getOptionalVector("action_scale"));
 
         return controller;
     }
@@ -179,6 +254,18 @@ T ControllersFactory::Impl::GetElementValueAs(
     return output;
 }
 
+void ControllersFactory::Impl::StringToStd(const std::string& string,
+                                           double& out)
+{
+    std::stringstream in(string);
+
+    // Manually set the locale
+    in.imbue(std::locale::classic());
+
+    out = 0.0;
+    in >> out;
+}
+
 void ControllersFactory::Impl::StringToStd(const std::string& string,
                                            std::vector<double>& out)
 {
@@ -28,24 +28,33 @@
 #include "scenario/gazebo/Joint.h"
 #include "scenario/gazebo/Log.h"
 #include "scenario/gazebo/Model.h"
+#include "scenario/gazebo/components/JointCommandQueue.h"
 #include "scenario/gazebo/components/JointControlMode.h"
 #include "scenario/gazebo/components/JointController.h"
+#include "scenario/gazebo/components/JointInterpolationDuration.h"
 #include "scenario/gazebo/components/JointPID.h"
+#include "scenario/gazebo/components/JointPIDBank.h"
 #include "scenario/gazebo/components/JointPositionTarget.h"
 #include "scenario/gazebo/components/JointVelocityTarget.h"
 #include "scenario/gazebo/helpers.h"
 
 #include <ignition/gazebo/Entity.hh>
 #include <ignition/gazebo/components/Joint.hh>
+#include <ignition/gazebo/components/JointForceCmd.hh>
+#include <ignition/gazebo/components/JointPosition.hh>
+#include <ignition/gazebo/components/JointVelocity.hh>
 #include <ignition/gazebo/components/JointVelocityCmd.hh>
 #include <ignition/gazebo/components/Name.hh>
 #include <ignition/gazebo/components/ParentEntity.hh>
+#include <ignition/gazebo/components/World.hh>
 #include <ignition/math/PID.hh>
 #include <ignition/plugin/Register.hh>
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <limits>
+#include <optional>
 #include <ratio>
 #include <string>
 #include <vector>
@@ -57,15 +66,18 @@ class JointController::Impl
 {
 public:
     ignition::gazebo::Entity modelEntity;
+    ignition::gazebo::Entity worldEntity = ignition::gazebo::kNullEntity;
     std::shared_ptr<scenario::gazebo::Model> model;
     std::chrono::steady_clock::duration prevUpdateTime{0};
 
-    static bool runPIDController(scenario::gazebo::Joint& joint,
-                                 const bool computeNewForce,
-                                 ignition::math::PID& pid,
-                                 const std::chrono::steady_clock::duration& dt,
-                                 const std::vector<double>& reference,
-                                 const std::vector<double>& current);
+    void buildPIDBank(utils::JointPIDBank& bank,
+                      const double time,
+                      ignition::gazebo::EntityComponentManager& ecm) const;
+
+    double interpolationDuration(
+        utils::JointPIDBank& bank,
+        const double time,
+        const ignition::gazebo::EntityComponentManager& ecm) const;
 };
 
 JointController::JointController()
@@ -91,6 +103,10 @@ void JointController::Configure(
     // Store the model entity
     pImpl->modelEntity = entity;
 
+    // Store the world entity, that holds the queue of the joint commands
+    pImpl->worldEntity = utils::getFirstParentEntityWithComponent<
+        ignition::gazebo::components::World>(&ecm, entity);
+
     // Create a model that will be given to the controller
     pImpl->model = std::make_shared<Model>();
 
@@ -168,91 +184,104 @@ void JointController::PreUpdate(const ignition::gazebo::UpdateInfo& info,
         computeNewForce = false;
     }
 
-    const auto positionControlledJoints = ecm.EntitiesByComponents(
-        ignition::gazebo::components::Joint(),
-        ignition::gazebo::components::ParentEntity(pImpl->modelEntity),
-        ignition::gazebo::components::JointControlMode(
-            core::JointControlMode::Position));
-
-    const auto positionInterpolatedControlledJoints = ecm.EntitiesByComponents(
-        ignition::gazebo::components::Joint(),
-        ignition::gazebo::components::ParentEntity(pImpl->modelEntity),
-        ignition::gazebo::components::JointControlMode(
-            core::JointControlMode::PositionInterpolated));
-
-    const auto velocityControlledJoints = ecm.EntitiesByComponents(
-        ignition::gazebo::components::Joint(),
-        ignition::gazebo::components::ParentEntity(pImpl->modelEntity),
-        ignition::gazebo::components::JointControlMode(
-            core::JointControlMode::Velocity));
-
-    const auto velocityFollowerDartControlledJoints = ecm.EntitiesByComponents(
-        ignition::gazebo::components::Joint(),
-        ignition::gazebo::components::ParentEntity(pImpl->modelEntity),
-        ignition::gazebo::components::JointControlMode(
-            core::JointControlMode::VelocityFollowerDart));
+    auto& bank = utils::getComponentData< //
+        ignition::gazebo::components::JointPIDBank>(&ecm, pImpl->modelEntity);
 
-    // Update PIDs for Revolute and Prismatic joints controlled in Position
-    for (const auto jointEntity : positionControlledJoints) {
+    const double time = duration<double>(info.simTime).count();
 
-        ignition::math::PID& pid = utils::getExistingComponentData< //
-            ignition::gazebo::components::JointPID>(&ecm, jointEntity);
-
-        std::string& jointName = utils::getExistingComponentData< //
-            ignition::gazebo::components::Name>(&ecm, jointEntity);
-
-        auto joint = pImpl->model->getJoint(jointName);
-        auto jointGazebo = std::static_pointer_cast<Joint>(joint);
+    // The bank is invalidated when the control mode or the PID of a joint
+    // changes
+    if (!bank.valid()) {
+        pImpl->buildPIDBank(bank, time, ecm);
+    }
 
-        const std::vector<double>& position = joint->jointPosition();
+    // Update the PIDs of the Revolute and Prismatic joints controlled in
+    // Position, PositionInterpolated and Velocity
+    if (computeNewForce) {
+        // Duration of the trajectories towards the targets changed since the
+        // last update, that are all planned with the same duration
+        std::optional<double> newTargetsDuration;
+
+        for (size_t i = 0; i < bank.size(); ++i) {
+            const auto jointEntity = bank.pidJoints[i];
+            const bool positionControlled = i < bank.numPositionControlled;
+
+            const std::vector<double>& current = positionControlled
+                ? utils::getExistingComponentData< //
+                    ignition::gazebo::components::JointPosition>(&ecm,
+                                                                 jointEntity)
+                : utils::getExistingComponentData< //
+                    ignition::gazebo::components::JointVelocity>(&ecm,
+                                                                 jointEntity);
+
+            const std::vector<double>& reference = positionControlled
+                ? utils::getExistingComponentData<
+                    ignition::gazebo::components::JointPositionTarget>(
+                    &ecm, jointEntity)
+                : utils::getExistingComponentData<
+                    ignition::gazebo::components::JointVelocityTarget>(
+                    &ecm, jointEntity);
+
+            assert(current.size() == 1);
+            assert(reference.size() == 1);
+
+            // Joints controlled in PositionInterpolated track the trajectory
+            // towards their target
+            if (i < bank.interpolatedBegin || i >= bank.numPositionControlled) {
+                bank.error[i] = current[0] - reference[0];
+                continue;
+            }
 
-        const std::vector<double>& positionTarget =
-            utils::getExistingComponentData<
-                ignition::gazebo::components::JointPositionTarget>(&ecm,
-                                                                   jointEntity);
+            auto& trajectory = bank.trajectories[i - bank.interpolatedBegin];
+            auto state = trajectory.evaluate(time);
+
+            if (reference[0] != trajectory.target) {
+                if (!newTargetsDuration) {
+                    newTargetsDuration =
+                        pImpl->interpolationDuration(bank, time, ecm);
+                }
+
+                trajectory.plan(time,
+                                newTargetsDuration.value(),
+                                state[0],
+                                state[1],
+                                state[2],
+                                reference[0]);
+                state = trajectory.evaluate(time);
+            }
 
-        if (!Impl::runPIDController(*jointGazebo,
-                                    computeNewForce,
-                                    pid,
-                                    info.dt,
-                                    positionTarget,
-                                    position)) {
-            sError << "Failed to run PID controller of joint " << joint->name()
-                   << " [" << jointEntity << "]" << std::endl;
+            bank.error[i] = current[0] - state[0];
         }
-    }
 
-    // TODO: Update PIDs for Revolute and Prismatic joints controlled in
-    //       PositionInterpolated
+        bank.update(info.dt);
+    }
 
-    // Update PIDs for Revolute and Prismatic joints controlled in Velocity
-    for (const auto jointEntity : velocityControlledJoints) {
+    // The commands are processed by the Physics system only if enqueued
+    utils::JointCommandQueue* queue = nullptr;
 
-        ignition::math::PID& pid = utils::getExistingComponentData<
-            ignition::gazebo::components::JointPID>(&ecm, jointEntity);
+    if (auto* queueComponent = ecm.Component< //
+            ignition::gazebo::components::JointCommandQueue>(
+            pImpl->worldEntity);
+        queueComponent) {
+        queue = queueComponent->Data().get();
+    }
 
-        std::string& jointName =
-            utils::getExistingComponentData<ignition::gazebo::components::Name>(
-                &ecm, jointEntity);
+    // Actuate the forces computed by the PIDs, or the ones of the last update
+    for (size_t i = 0; i < bank.size(); ++i) {
+        const auto jointEntity = bank.pidJoints[i];
 
-        auto joint = pImpl->model->getJoint(jointName);
-        auto jointGazebo = std::static_pointer_cast<Joint>(joint);
+        auto& jointForceCmd = utils::getComponentData< //
+            ignition::gazebo::components::JointForceCmd>(&ecm, jointEntity);
 
-        const std::vector<double>& velocity = joint->jointVelocity();
+        if (jointForceCmd.size() != 1) {
+            assert(jointForceCmd.size() == 0);
+            jointForceCmd = std::vector<double>(1, 0.0);
+        }
 
-        const std::vector<double>& velocityTarget =
-            utils::getExistingComponentData<
-                ignition::gazebo::components::JointVelocityTarget>(&ecm,
-                                                                   jointEntity);
+        jointForceCmd[0] = bank.cmd[i];
 
-        if (!Impl::runPIDController(*jointGazebo,
-                                    computeNewForce,
-                                    pid,
-                                    info.dt,
-                                    velocityTarget,
-                                    velocity)) {
-            sError << "Failed to run PID controller of joint " << joint->name()
-                   << " [" << jointEntity << "]" << std::endl;
+        if (queue) {
+            queue->push(jointEntity);
         }
     }
 
@@ -260,75 +289,171 @@ void JointController::PreUpdate(const ignition::gazebo::UpdateInfo& info,
     // VelocityDirect. This control mode computes and applies the right force
     // to get the desired velocity at the next step. It can be thought as an
     // ideal velocity PID.
-    for (const auto jointEntity : velocityFollowerDartControlledJoints) {
-
-        const std::string& jointName =
-            utils::getExistingComponentData<ignition::gazebo::components::Name>(
-                &ecm, jointEntity);
-
-        const auto joint = pImpl->model->getJoint(jointName);
+    for (const auto jointEntity : bank.velocityFollowerJoints) {
 
         const std::vector<double>& velocityTarget =
             utils::getExistingComponentData<
                 ignition::gazebo::components::JointVelocityTarget>(&ecm,
                                                                    jointEntity);
 
-        auto& jointVelocityCmd = utils::getComponentData< //
-            ignition::gazebo::components::JointVelocityCmd>(&ecm, jointEntity);
+        // Set the target
+        utils::getComponentData< //
+            ignition::gazebo::components::JointVelocityCmd>(
+            &ecm, jointEntity) = velocityTarget;
 
-        if (jointVelocityCmd.size() != joint->dofs()) {
-            assert(jointVelocityCmd.size() == 0);
-            jointVelocityCmd = std::vector<double>(joint->dofs(), 0.0);
+        if (queue) {
+            queue->push(jointEntity);
         }
-
-        // Set the target
-        jointVelocityCmd = velocityTarget;
     }
 }
 
-bool JointController::Impl::runPIDController(
-    scenario::gazebo::Joint& joint,
-    const bool computeNewForce,
-    ignition::math::PID& pid,
-    const std::chrono::steady_clock::duration& dt,
-    const std::vector<double>& reference,
-    const std::vector<double>& current)
+void JointController::Impl::buildPIDBank(
+    utils::JointPIDBank& bank,
+    const double time,
+    ignition::gazebo::EntityComponentManager& ecm) const
 {
-    switch (joint.type()) {
+    // The PIDs and the trajectories of the joints that were not invalidated
+    // continue from their state in the previous bank
+    const utils::JointPIDBank previous = std::move(bank);
+
+    // Index of the PID of a joint in the previous bank, if still valid
+    auto previousIndex = [&previous](const ignition::gazebo::Entity entity)
+        -> std::optional<size_t> {
+        const auto& joints = previous.pidJoints;
+        const auto it = std::find(joints.begin(), joints.end(), entity);
+
+        if (it == joints.end() || previous.invalidated(entity)) {
+            return {};
+        }
 
-        case core::JointType::Revolute:
-        case core::JointType::Prismatic: {
+        return static_cast<size_t>(it - joints.begin());
+    };
 
-            double force;
+    auto wasInterpolated = [&previous](const size_t index) {
+        return index >= previous.interpolatedBegin
+               && index < previous.numPositionControlled;
+    };
 
-            if (computeNewForce) {
-                assert(current.size() == 1);
-                assert(reference.size() == 1);
+    bank.clear();
+    bank.lastTargetTime = previous.lastTargetTime;
 
-                double error = current[0] - reference[0];
-                force = pid.Update(error, dt);
-            }
-            else {
-                force = pid.Cmd();
-            }
+    for (const auto jointEntity : ecm.EntitiesByComponents(
+             ignition::gazebo::components::Joint(),
+             ignition::gazebo::components::ParentEntity(this->modelEntity))) {
+
+        if (const auto* mode =
+                ecm.Component<ignition::gazebo::components::JointControlMode>(
+                    jointEntity)) {
+            bank.joints.push_back(jointEntity);
+            bank.modes.push_back(mode->Data());
+        }
+    }
+
+    auto pushPID = [&](const ignition::gazebo::Entity jointEntity) -> bool {
+        const std::string& jointName =
+            utils::getExistingComponentData<ignition::gazebo::components::Name>(
+                &ecm, jointEntity);
 
-            if (!joint.setGeneralizedForceTarget(force)) {
-                sError << "Failed to set force of joint " << joint.name()
-                       << std::endl;
+        const auto joint = this->model->getJoint(jointName);
+
+        switch (joint->type()) {
+            case core::JointType::Revolute:
+            case core::JointType::Prismatic:
+                bank.push(jointEntity,
+                          utils::getExistingComponentData<
+                              ignition::gazebo::components::JointPID>(
+                              &ecm, jointEntity));
+
+                if (const auto index = previousIndex(jointEntity)) {
+                    bank.restore(bank.size() - 1, previous, index.value());
+                }
+
+                return true;
+            case core::JointType::Fixed:
+            case core::JointType::Ball:
+            case core::JointType::Invalid:
+                sWarning << "Type of joint '" << joint->name()
+                         << " not supported" << std::endl;
                 return false;
-            }
-            return true;
         }
-        case core::JointType::Fixed:
-        case core::JointType::Ball:
-        case core::JointType::Invalid:
-            sWarning << "Type of joint '" << joint.name() << " not supported"
-                     << std::endl;
-            return true;
+
+        return false;
+    };
+
+    // The joints controlled in Position are stored first
+    for (size_t i = 0; i < bank.joints.size(); ++i) {
+        if (bank.modes[i] == core::JointControlMode::Position) {
+            pushPID(bank.joints[i]);
+        }
     }
 
-    return false;
-};
+    // The trajectories of the joints controlled in PositionInterpolated start
+    // at rest from their current position
+    bank.interpolatedBegin = bank.size();
+
+    for (size_t i = 0; i < bank.joints.size(); ++i) {
+        if (bank.modes[i] != core::JointControlMode::PositionInterpolated
+            || !pushPID(bank.joints[i])) {
+            continue;
+        }
+
+        if (const auto index = previousIndex(bank.joints[i]);
+            index && wasInterpolated(index.value())) {
+            bank.trajectories.push_back(
+                previous.trajectories[index.value()
+                                      - previous.interpolatedBegin]);
+            continue;
+        }
+
+        const std::vector<double>& position = utils::getExistingComponentData<
+            ignition::gazebo::components::JointPosition>(&ecm, bank.joints[i]);
+
+        const double initialPosition = position.empty() ? 0.0 : position[0];
+
+        utils::MinimumJerkTrajectory trajectory;
+        trajectory.plan(time, 0.0, initialPosition, 0.0, 0.0, initialPosition);
+        bank.trajectories.push_back(trajectory);
+    }
+
+    bank.numPositionControlled = bank.size();
+
+    for (size_t i = 0; i < bank.joints.size(); ++i) {
+        switch (bank.modes[i]) {
+            case core::JointControlMode::Velocity:
+                pushPID(bank.joints[i]);
+                break;
+            case core::JointControlMode::VelocityFollowerDart:
+                bank.velocityFollowerJoints.push_back(bank.joints[i]);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+double JointController::Impl::interpolationDuration(
+    utils::JointPIDBank& bank,
+    const double time,
+    const ignition::gazebo::EntityComponentManager& ecm) const
+{
+    // Time elapsed since the previous change of the targets, that for
+    // agents setting the targets at a fixed rate is their period
+    const double elapsed = bank.lastTargetTime
+                               ? time - bank.lastTargetTime.value()
+                               : this->model->controllerPeriod();
+    bank.lastTargetTime = time;
+
+    // The duration configured in the model takes precedence
+    const auto* durationComponent = ecm.Component< //
+        ignition::gazebo::components::JointInterpolationDuration>(
+        this->modelEntity);
+
+    if (durationComponent) {
+        return utils::steadyClockDurationToDouble(durationComponent->Data());
+    }
+
+    return elapsed;
+}
 
 IGNITION_ADD_PLUGIN(
     scenario::plugins::gazebo::JointController,
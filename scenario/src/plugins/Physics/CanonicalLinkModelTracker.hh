@@ -17,12 +17,18 @@
 #ifndef IGNITION_GAZEBO_SYSTEMS_PHYSICS_CANONICAL_LINK_MODEL_TRACKER_HH_
 #define IGNITION_GAZEBO_SYSTEMS_PHYSICS_CANONICAL_LINK_MODEL_TRACKER_HH_
 
+#include <algorithm>
+#include <cstdint>
 #include <set>
 #include <unordered_map>
+#include <vector>
+
+#include <ignition/physics/FrameData.hh>
 
 #include "ignition/gazebo/Entity.hh"
 #include "ignition/gazebo/EntityComponentManager.hh"
 #include "ignition/gazebo/components/CanonicalLink.hh"
+#include "ignition/gazebo/components/Link.hh"
 #include "ignition/gazebo/components/Model.hh"
 #include "ignition/gazebo/config.hh"
 
@@ -71,6 +77,38 @@ namespace systems::physics_system
     /// \param[in] _link The link to remove
     public: void RemoveLink(const Entity &_link);
 
+    /// \brief Assign a slot to the links created since the last call. Slots
+    /// index the persistent buffers used to store per-link data. The slots of
+    /// removed links are reused, therefore the slot order is not the
+    /// topological order of the links, that is kept by the slot ranks.
+    /// \param[in] _ecm EntityComponentManager
+    public: void AddNewLinks(const EntityComponentManager &_ecm);
+
+    /// \brief Get the slot of a link, assigning a new one if the link was not
+    /// yet tracked.
+    /// \param[in] _link The link
+    /// \return The slot of the link
+    public: std::size_t LinkSlot(const Entity _link);
+
+    /// \brief Get the number of slots assigned so far, including the free
+    /// ones of removed links.
+    /// \return The number of slots
+    public: std::size_t LinkSlotCount() const;
+
+    /// \brief Get the rank of a slot, that is the position of its link in
+    /// topological order (ascending entity ids).
+    /// \param[in] _slot The slot
+    /// \return The rank of the slot
+    public: std::size_t LinkSlotRank(const std::size_t _slot) const;
+
+    /// \brief Get the slot with a given rank.
+    /// \param[in] _rank The rank
+    /// \return The slot with this rank
+    public: std::size_t RankLinkSlot(const std::size_t _rank) const;
+
+    /// \brief Sort the slots in topological order, if needed.
+    private: void UpdateRanks();
+
     /// \brief A mapping of canonical links to the models that have this
     /// canonical link. The key is the canonical link entity, and the value is
     /// the model entities that have this canonical link. The models in the
@@ -80,6 +118,102 @@ namespace systems::physics_system
     /// \brief An empty set of models that is returned from the
     /// CanonicalLinkModels method for links that map to no models
     private: const std::set<Entity> emptyModelOrdering{};
+
+    /// \brief The slots of the tracked links.
+    private: std::unordered_map<Entity, std::size_t> linkSlots;
+
+    /// \brief The link associated to each slot. Free slots store kNullEntity.
+    private: std::vector<Entity> slotLinks;
+
+    /// \brief The slots of removed links, reused by new links.
+    private: std::vector<std::size_t> freeSlots;
+
+    /// \brief The rank of each slot.
+    private: std::vector<std::size_t> slotRanks;
+
+    /// \brief The slots sorted in topological order.
+    private: std::vector<std::size_t> rankSlots;
+
+    /// \brief Whether the ranks have to be sorted again. New links usually
+    /// have the largest entity id and they are ranked last without sorting.
+    private: bool ranksDirty{false};
+  };
+
+  /// \brief Buffer of the links that experienced a pose change in the most
+  /// recent physics step, together with their frame data.
+  ///
+  /// The buffer is indexed by the link slots assigned by
+  /// CanonicalLinkModelTracker and it is reused across steps: its storage
+  /// only grows when new links are created, so that steady-state steps do
+  /// not allocate. Links can be visited in topological order (ascending
+  /// entity ids) with PopNext, also while new links are being added. The
+  /// order is the one cached by the tracker in the slot ranks.
+  class ChangedLinkBuffer
+  {
+    /// \brief Clear the buffer before a new step.
+    /// \param[in] _tracker The tracker that assigned the link slots
+    public: void Reset(const CanonicalLinkModelTracker &_tracker);
+
+    /// \brief Check if a link is in the buffer.
+    /// \param[in] _slot The slot of the link
+    /// \return True if the link changed in this step
+    public: bool Contains(const std::size_t _slot) const;
+
+    /// \brief Add a link to the buffer or update its frame data.
+    /// \param[in] _slot The slot of the link
+    /// \param[in] _link The link entity
+    /// \param[in] _frameData The frame data of the link
+    public: void Set(const std::size_t _slot, const Entity _link,
+                const physics::FrameData3d &_frameData);
+
+    /// \brief Get the frame data of a link in the buffer.
+    /// \param[in] _slot The slot of the link
+    /// \return The frame data of the link
+    public: const physics::FrameData3d &FrameData(
+                const std::size_t _slot) const;
+
+    /// \brief Get the link stored in a slot.
+    /// \param[in] _slot The slot of the link
+    /// \return The link entity
+    public: Entity Link(const std::size_t _slot) const;
+
+    /// \brief Get the next link not yet visited in topological order.
+    /// \param[out] _slot The slot of the link
+    /// \return False if all the links in the buffer were visited
+    public: bool PopNext(std::size_t &_slot);
+
+    /// \brief Get the slots of the links in the buffer, in insertion order.
+    /// \return The slots of the changed links
+    public: const std::vector<std::size_t> &Slots() const;
+
+    /// \brief Grow the storage to hold at least the given number of slots.
+    /// \param[in] _numSlots The number of slots
+    private: void Reserve(const std::size_t _numSlots);
+
+    /// \brief The frame data of each slot.
+    private: std::vector<physics::FrameData3d> frameData;
+
+    /// \brief The link of each slot.
+    private: std::vector<Entity> links;
+
+    /// \brief The step in which each slot was last changed. Comparing it
+    /// with the current step avoids clearing the buffer at every step.
+    private: std::vector<uint64_t> stamps;
+
+    /// \brief The current step.
+    private: uint64_t stamp{0};
+
+    /// \brief The slots changed in the current step.
+    private: std::vector<std::size_t> changed;
+
+    /// \brief The tracker that assigned the link slots.
+    private: const CanonicalLinkModelTracker *tracker{nullptr};
+
+    /// \brief Bitset of the ranks of the slots not yet visited.
+    private: std::vector<uint64_t> pending;
+
+    /// \brief No rank lower than this one is pending.
+    private: std::size_t nextRank{0};
   };
 
   void CanonicalLinkModelTracker::AddNewModels(
@@ -108,6 +242,183 @@ namespace systems::physics_system
   void CanonicalLinkModelTracker::RemoveLink(const Entity &_link)
   {
     this->linkModelMap.erase(_link);
+
+    auto it = this->linkSlots.find(_link);
+    if (it != this->linkSlots.end())
+    {
+      this->slotLinks[it->second] = kNullEntity;
+      this->freeSlots.push_back(it->second);
+      this->linkSlots.erase(it);
+    }
+  }
+
+  void CanonicalLinkModelTracker::AddNewLinks(
+      const EntityComponentManager &_ecm)
+  {
+    _ecm.EachNew<components::Link>(
+        [this](const Entity &_link, const components::Link *)
+        {
+          this->LinkSlot(_link);
+          return true;
+        });
+
+    this->UpdateRanks();
+  }
+
+  std::size_t CanonicalLinkModelTracker::LinkSlot(const Entity _link)
+  {
+    auto it = this->linkSlots.find(_link);
+    if (it != this->linkSlots.end())
+      return it->second;
+
+    // The new link is ranked last, and the ranks are sorted again only if
+    // it does not have the largest entity id
+    if (!this->rankSlots.empty() &&
+        this->slotLinks[this->rankSlots.back()] > _link)
+    {
+      this->ranksDirty = true;
+    }
+
+    std::size_t slot;
+    if (!this->freeSlots.empty())
+    {
+      slot = this->freeSlots.back();
+      this->freeSlots.pop_back();
+      this->slotLinks[slot] = _link;
+
+      // The reused slot keeps the rank of the removed link until sorting
+      this->ranksDirty = true;
+    }
+    else
+    {
+      slot = this->slotLinks.size();
+      this->slotLinks.push_back(_link);
+      this->slotRanks.push_back(this->rankSlots.size());
+      this->rankSlots.push_back(slot);
+    }
+
+    this->linkSlots.emplace(_link, slot);
+    return slot;
+  }
+
+  std::size_t CanonicalLinkModelTracker::LinkSlotCount() const
+  {
+    return this->slotLinks.size();
+  }
+
+  std::size_t CanonicalLinkModelTracker::LinkSlotRank(
+      const std::size_t _slot) const
+  {
+    return this->slotRanks[_slot];
+  }
+
+  std::size_t CanonicalLinkModelTracker::RankLinkSlot(
+      const std::size_t _rank) const
+  {
+    return this->rankSlots[_rank];
+  }
+
+  void CanonicalLinkModelTracker::UpdateRanks()
+  {
+    if (!this->ranksDirty)
+      return;
+
+    // Free slots store kNullEntity and they are ranked last
+    std::sort(this->rankSlots.begin(), this->rankSlots.end(),
+        [this](const std::size_t _a, const std::size_t _b)
+        {
+          return this->slotLinks[_a] < this->slotLinks[_b];
+        });
+
+    for (std::size_t rank = 0; rank < this->rankSlots.size(); ++rank)
+      this->slotRanks[this->rankSlots[rank]] = rank;
+
+    this->ranksDirty = false;
+  }
+
+  void ChangedLinkBuffer::Reset(const CanonicalLinkModelTracker &_tracker)
+  {
+    this->tracker = &_tracker;
+    this->Reserve(_tracker.LinkSlotCount());
+    this->changed.clear();
+    std::fill(this->pending.begin(), this->pending.end(), 0);
+    this->nextRank = 0;
+    ++this->stamp;
+  }
+
+  bool ChangedLinkBuffer::Contains(const std::size_t _slot) const
+  {
+    return _slot < this->stamps.size() && this->stamps[_slot] == this->stamp;
+  }
+
+  void ChangedLinkBuffer::Set(const std::size_t _slot, const Entity _link,
+      const physics::FrameData3d &_frameData)
+  {
+    this->Reserve(_slot + 1);
+    this->frameData[_slot] = _frameData;
+
+    if (this->stamps[_slot] == this->stamp)
+      return;
+
+    this->stamps[_slot] = this->stamp;
+    this->links[_slot] = _link;
+    this->changed.push_back(_slot);
+
+    // Links set while visiting are visited next if they precede the last
+    // visited one
+    const std::size_t rank = this->tracker->LinkSlotRank(_slot);
+    this->pending[rank / 64] |= uint64_t{1} << (rank % 64);
+    this->nextRank = std::min(this->nextRank, rank);
+  }
+
+  const physics::FrameData3d &ChangedLinkBuffer::FrameData(
+      const std::size_t _slot) const
+  {
+    return this->frameData[_slot];
+  }
+
+  Entity ChangedLinkBuffer::Link(const std::size_t _slot) const
+  {
+    return this->links[_slot];
+  }
+
+  bool ChangedLinkBuffer::PopNext(std::size_t &_slot)
+  {
+    for (std::size_t word = this->nextRank / 64;
+         word < this->pending.size(); ++word)
+    {
+      if (this->pending[word] == 0)
+        continue;
+
+      std::size_t bit = 0;
+      while (((this->pending[word] >> bit) & 1) == 0)
+        ++bit;
+
+      this->pending[word] &= ~(uint64_t{1} << bit);
+      const std::size_t rank = word * 64 + bit;
+      this->nextRank = rank + 1;
+      _slot = this->tracker->RankLinkSlot(rank);
+      return true;
+    }
+
+    this->nextRank = this->pending.size() * 64;
+    return false;
+  }
+
+  const std::vector<std::size_t> &ChangedLinkBuffer::Slots() const
+  {
+    return this->changed;
+  }
+
+  void ChangedLinkBuffer::Reserve(const std::size_t _numSlots)
+  {
+    if (this->stamps.size() >= _numSlots)
+      return;
+
+    this->frameData.resize(_numSlots);
+    this->links.resize(_numSlots, kNullEntity);
+    this->stamps.resize(_numSlots, 0);
+    this->pending.resize((_numSlots + 63) / 64, 0);
   }
 }
 }
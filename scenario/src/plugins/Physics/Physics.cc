@@ -28,6 +28,7 @@
 #include <deque>
 #include <map>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -134,9 +135,17 @@
 #include "EntityFeatureMap.hh"
 
 // Extra components
+#include "scenario/gazebo/components/ContactAccumulator.h"
+#include "scenario/gazebo/components/ContactBuffer.h"
+#include "scenario/gazebo/components/ContactFilter.h"
 #include "scenario/gazebo/components/ExternalWorldWrenchCmdWithDuration.h"
-#include "scenario/gazebo/components/HistoryOfAppliedJointForces.h"
 #include "scenario/gazebo/components/JointAcceleration.h"
+#include "scenario/gazebo/components/JointCommandQueue.h"
+#include "scenario/gazebo/components/JointHistory.h"
+#include "scenario/gazebo/components/JointPositionTarget.h"
+#include "scenario/gazebo/components/JointStateCache.h"
+#include "scenario/gazebo/components/JointTrajectoryBuffer.h"
+#include "scenario/gazebo/components/JointVelocityTarget.h"
 #include <ignition/gazebo/components/JointForce.hh>
 #include "scenario/gazebo/components/SimulatedTime.h"
 
@@ -230,17 +239,30 @@ class ignition::gazebo::systems::PhysicsPrivate
   public: ignition::physics::ForwardStep::Output Step(
               const std::chrono::steady_clock::duration &_dt);
 
+  /// \brief Step the simulation for each world splitting the duration in
+  /// the configured number of sub-steps
+  /// \param[in] _dt Duration of all the sub-steps
+  /// \returns Output data from the physics engine, with the links that
+  /// experienced a pose change in any of the sub-steps
+  public: ignition::physics::ForwardStep::Output StepWithSubsteps(
+              const std::chrono::steady_clock::duration &_dt);
+
+  /// \brief Apply again the commands held during the sub-steps
+  public: void ReapplyHeldCommands();
+
   /// \brief Get data of links that were updated in the latest physics step.
   /// \param[in] _ecm Mutable reference to ECM.
   /// \param[in] _updatedLinks Updated link poses from the latest physics step
   /// that were written to by the physics engine (some physics engines may
   /// not write this data to ForwardStep::Output. If not, _ecm is used to get
   /// this updated link pose data).
-  /// \return A map of gazebo link entities to their updated pose data.
-  /// std::map is used because canonical links must be in topological order
-  /// to ensure that nested models with multiple canonical links are updated
-  /// properly (models must be updated in topological order).
-  public: std::map<Entity, physics::FrameData3d> ChangedLinks(
+  /// \return A buffer of gazebo link entities and their updated pose data.
+  /// The buffer can be visited in topological order, since canonical links
+  /// must be in topological order to ensure that nested models with multiple
+  /// canonical links are updated properly (models must be updated in
+  /// topological order). The buffer is owned by this class and it is reused
+  /// across steps.
+  public: ChangedLinkBuffer &ChangedLinks(
               EntityComponentManager &_ecm,
               const ignition::physics::ForwardStep::Output &_updatedLinks);
 
@@ -257,7 +279,7 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// updated since nested model poses are saved w.r.t. the parent model).
   public: void UpdateModelPose(const Entity _model,
               const Entity _canonicalLink, EntityComponentManager &_ecm,
-              std::map<Entity, physics::FrameData3d> &_linkFrameData);
+              ChangedLinkBuffer &_linkFrameData);
 
   /// \brief Get an entity's frame data relative to world from physics.
   /// \param[in] _entity The entity.
@@ -273,13 +295,20 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// most recent physics step. The key is the entity of the link, and the
   /// value is the updated frame data corresponding to that entity.
   public: void UpdateSim(EntityComponentManager &_ecm,
-              std::map<Entity, physics::FrameData3d> &_linkFrameData,
+              ChangedLinkBuffer &_linkFrameData,
               const ignition::gazebo::UpdateInfo &_info);
 
   /// \brief Update collision components from physics simulation
   /// \param[in] _ecm Mutable reference to ECM.
   public: void UpdateCollisions(EntityComponentManager &_ecm);
 
+  /// \brief Accumulate the contacts of the last step in the
+  /// ContactAccumulator components of the links
+  /// \param[in] _ecm Mutable reference to ECM.
+  /// \param[in] _info Update information.
+  public: void AccumulateContacts(EntityComponentManager &_ecm,
+              const ignition::gazebo::UpdateInfo &_info);
+
   /// \brief FrameData relative to world at a given offset pose
   /// \param[in] _link ign-physics link
   /// \param[in] _pose Offset pose in which to compute the frame data
@@ -299,6 +328,11 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// The key is an entity and the value is its top level model.
   public: std::unordered_map<Entity, Entity> topLevelModelMap;
 
+  /// \brief Cache the bodies of each collision, used to filter the contacts.
+  /// The key is a collision and the value contains its link followed by the
+  /// models that contain it, up to the top-level model.
+  public: std::unordered_map<Entity, std::vector<Entity>> collisionBodies;
+
   /// \brief Keep track of what entities are static (models and links).
   public: std::unordered_set<Entity> staticEntities;
 
@@ -312,11 +346,83 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// physics step
   public: CanonicalLinkModelTracker canonicalLinkModelTracker;
 
+  /// \brief Links that experienced a pose change in the most recent physics
+  /// step. The buffer is indexed by the link slots of
+  /// canonicalLinkModelTracker and reused across steps.
+  public: ChangedLinkBuffer changedLinks;
+
   /// \brief Keep track of non-static model world poses. Since non-static
   /// models may not move on a given iteration, we want to keep track of the
   /// most recent model world pose change that took place.
   public: std::unordered_map<Entity, math::Pose3d> modelWorldPoses;
 
+  /// \brief Number of engine steps executed in each update of the system
+  public: std::size_t substeps{1};
+
+  /// \brief Whether systems that do not use the joint command queue write
+  /// joint commands in the ECM, in addition to those inserted through the
+  /// scenario APIs that mark the queue automatically
+  public: bool externalJointCommands{false};
+
+  /// \brief Commands applied by UpdatePhysics that the engine clears after
+  /// each step. They are applied again before each sub-step.
+  public: struct HeldCommands
+  {
+    /// \brief Joint force commands
+    std::vector<std::pair<Entity, std::vector<double>>> jointForces;
+
+    /// \brief Joint velocity commands
+    std::vector<std::pair<Entity, std::vector<double>>> jointVelocities;
+
+    /// \brief Link wrenches expressed as force and torque
+    std::vector<std::tuple<Entity, math::Vector3d, math::Vector3d>>
+        linkWrenches;
+
+    /// \brief Remove all the commands
+    void Clear()
+    {
+      this->jointForces.clear();
+      this->jointVelocities.clear();
+      this->linkWrenches.clear();
+    }
+  };
+
+  /// \brief Commands held during the sub-steps of the current update
+  public: HeldCommands heldCommands;
+
+  /// \brief Linear and angular velocity below which the links of a model
+  /// are considered at rest. Sleeping is disabled if not positive.
+  public: double sleepVelocityThreshold{0.0};
+
+  /// \brief Number of consecutive steps at rest after which a model sleeps
+  public: uint64_t sleepSteps{100};
+
+  /// \brief Iteration in which each top-level model was last active
+  public: std::unordered_map<Entity, uint64_t> modelLastActive;
+
+  /// \brief Iteration of the current update
+  public: uint64_t iteration{0};
+
+  /// \brief Links that moved in the last step, before filtering the ones
+  /// of sleeping models
+  public: std::vector<std::pair<Entity, physics::FrameData3d>> movedLinks;
+
+  /// \brief Check if the detection of sleeping models is enabled
+  /// \return True if sleeping is enabled
+  public: bool SleepingEnabled() const;
+
+  /// \brief Check if a model is sleeping
+  /// \param[in] _entity Any entity of the model
+  /// \return True if the top-level model of the entity is sleeping
+  public: bool IsSleeping(const Entity _entity) const;
+
+  /// \brief Wake up a model, if sleeping
+  /// \param[in] _entity Any entity of the model
+  public: void WakeUp(const Entity _entity);
+
+  /// \brief Wake up the sleeping models in contact with awake ones
+  public: void WakeUpOnContacts();
+
   /// \brief A map between model entity ids in the ECM to whether its battery
   /// has drained.
   public: std::unordered_map<Entity, bool> entityOffMap;
@@ -594,6 +700,44 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// ign-physics
   public: EntityJointMap entityJointMap;
 
+  /// \brief Entry of the flat array used to write back the joint state.
+  public: struct JointWriteBack
+  {
+    /// \brief The joint entity in the ECM.
+    Entity entity;
+
+    /// \brief The joint entity in ign-physics.
+    EntityJointMap::RequiredEntityPtr jointPhys;
+
+    /// \brief The number of degrees of freedom of the joint.
+    std::size_t dofs;
+
+    /// \brief The top-level model of the joint.
+    Entity model;
+
+    /// \brief The joint state cache of the model, nullptr if missing, and
+    /// the range of the joint in its buffers.
+    scenario::gazebo::utils::JointStateCache *cache = nullptr;
+    std::size_t cacheOffset = 0;
+    std::size_t cacheDofs = 0;
+  };
+
+  /// \brief Flat array of the joints whose state is written back to the ECM
+  /// after a physics step. It is rebuilt only when entities are created or
+  /// removed, or when the joint state caches change, avoiding the lookup of
+  /// the physics joint and of its range in the cache. The state components
+  /// are not stored, since they can be created after their joint and their
+  /// storage moves when components of the same type are created.
+  public: std::vector<JointWriteBack> jointWriteBack;
+
+  /// \brief The joint state caches referenced by jointWriteBack, with the
+  /// top-level model they belong to.
+  public: std::vector<std::pair<Entity,
+      scenario::gazebo::utils::JointStateCache *>> jointStateCaches;
+
+  /// \brief True when the jointWriteBack array has to be rebuilt.
+  public: bool jointWriteBackDirty = true;
+
   /// \brief Collision EntityFeatureMap
   public: using EntityCollisionMap = EntityFeatureMap3d<
             physics::Shape,
@@ -617,6 +761,9 @@ class ignition::gazebo::systems::PhysicsPrivate
   /// in ign-physics.
   public: EntityFreeGroupMap entityFreeGroupMap;
 
+  /// \brief The world entity associated to this system.
+  public: Entity worldEntity = kNullEntity;
+
   /// \brief Boolean value that is true only the first call of Configure and
   /// PreUpdate.
   bool firstRun = true;
@@ -634,6 +781,47 @@ void Physics::Configure(const Entity &_entity,
     EventManager &/*_eventMgr*/)
 {
   std::string pluginLib;
+  this->dataPtr->worldEntity = _entity;
+
+  if (_sdf->HasElement("sleep_velocity_threshold"))
+  {
+    this->dataPtr->sleepVelocityThreshold =
+        _sdf->Get<double>("sleep_velocity_threshold");
+  }
+
+  if (_sdf->HasElement("sleep_steps"))
+  {
+    const int sleepSteps = _sdf->Get<int>("sleep_steps");
+    if (sleepSteps < 1)
+    {
+      ignerr << "The number of sleep steps must be positive, found ["
+             << sleepSteps << "]. Using the default value." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->sleepSteps = static_cast<uint64_t>(sleepSteps);
+    }
+  }
+
+  if (_sdf->HasElement("substeps"))
+  {
+    const int substeps = _sdf->Get<int>("substeps");
+    if (substeps < 1)
+    {
+      ignerr << "The number of substeps must be positive, found ["
+             << substeps << "]. Using a single step." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->substeps = static_cast<std::size_t>(substeps);
+    }
+  }
+
+  if (_sdf->HasElement("external_joint_commands"))
+  {
+    this->dataPtr->externalJointCommands =
+        _sdf->Get<bool>("external_joint_commands");
+  }
 
   // 1. Engine from component (from command line / ServerConfig)
   auto engineComp = _ecm.Component<components::PhysicsEnginePlugin>(_entity);
@@ -777,15 +965,16 @@ void Physics::Update(const UpdateInfo &_info, EntityComponentManager &_ecm)
 
   if (this->dataPtr->engine)
   {
+    this->dataPtr->iteration = _info.iterations;
     this->dataPtr->CreatePhysicsEntities(_ecm);
     this->dataPtr->UpdatePhysics(_ecm, _info);
     ignition::physics::ForwardStep::Output stepOutput;
     // Only step if not paused.
     if (!_info.paused)
     {
-      stepOutput = this->dataPtr->Step(_info.dt);
+      stepOutput = this->dataPtr->StepWithSubsteps(_info.dt);
     }
-    auto changedLinks = this->dataPtr->ChangedLinks(_ecm, stepOutput);
+    auto &changedLinks = this->dataPtr->ChangedLinks(_ecm, stepOutput);
     this->dataPtr->UpdateSim(_ecm, changedLinks, _info);
 
     // Entities scheduled to be removed should be removed from physics after the
@@ -1286,6 +1475,14 @@ void PhysicsPrivate::CreateCollisionEntities(const EntityComponentManager &_ecm)
 
         this->entityCollisionMap.AddEntity(_entity, collisionPtrPhys);
 
+        auto &bodies = this->collisionBodies[_entity];
+        for (Entity body = _ecm.ParentEntity(_entity);
+             body != kNullEntity && body != this->worldEntity;
+             body = _ecm.ParentEntity(body))
+        {
+          bodies.push_back(body);
+        }
+
         // Check that the physics engine has a filter mask feature
         // Set the collide_bitmask if it does
         auto filterMaskFeature =
@@ -1412,6 +1609,7 @@ void PhysicsPrivate::CreateJointEntities(const EntityComponentManager &_ecm)
           this->entityJointMap.AddEntity(_entity, jointPtrPhys);
           this->topLevelModelMap.insert(std::make_pair(_entity,
               topLevelModel(_entity, _ecm)));
+          this->jointWriteBackDirty = true;
         }
         return true;
       };
@@ -1578,6 +1776,7 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
             {
               this->entityCollisionMap.Remove(childCollision);
               this->topLevelModelMap.erase(childCollision);
+              this->collisionBodies.erase(childCollision);
             }
             this->entityLinkMap.Remove(childLink);
             this->topLevelModelMap.erase(childLink);
@@ -1591,6 +1790,7 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
           {
             this->entityJointMap.Remove(childJoint);
             this->topLevelModelMap.erase(childJoint);
+            this->jointWriteBackDirty = true;
           }
 
           this->entityFreeGroupMap.Remove(_entity);
@@ -1600,6 +1800,10 @@ void PhysicsPrivate::RemovePhysicsEntities(const EntityComponentManager &_ecm)
           this->topLevelModelMap.erase(_entity);
           this->staticEntities.erase(_entity);
           this->modelWorldPoses.erase(_entity);
+
+          // Removing a model could leave the models it was supporting
+          // without support, therefore all the models are woken up
+          this->modelLastActive.clear();
         }
         return true;
       });
@@ -1655,8 +1859,15 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
         return true;
       });
 
+  // The commands are cleared by the engine after each step, therefore they
+  // have to be stored to be applied again before each sub-step
+  const bool holdCommands = this->substeps > 1 && !_info.paused;
+  this->heldCommands.Clear();
+
+  const bool sleepingEnabled = this->SleepingEnabled();
+
   // Handle joint state
-  _ecm.Each<components::Joint, components::Name>(
+  auto processJointCommands =
       [&](const Entity &_entity, const components::Joint *,
           const components::Name *_name)
       {
@@ -1690,6 +1901,18 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
             if (haltMotion && jointVelFeature)
               jointVelFeature->SetVelocityCommand(i, 0);
           }
+
+          if (holdCommands)
+          {
+            this->heldCommands.jointForces.emplace_back(
+                _entity, std::vector<double>(nDofs, 0.0));
+
+            if (haltMotion && jointVelFeature)
+            {
+              this->heldCommands.jointVelocities.emplace_back(
+                  _entity, std::vector<double>(nDofs, 0.0));
+            }
+          }
           return true;
         }
 
@@ -1698,6 +1921,27 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
         auto velReset = _ecm.Component<components::JointVelocityReset>(
             _entity);
 
+        // Resets and non-zero commands wake up sleeping models
+        if (sleepingEnabled)
+        {
+          auto nonZero = [](const std::vector<double> &_values)
+          {
+            return std::any_of(_values.begin(), _values.end(),
+                [](const double _value) { return _value != 0.0; });
+          };
+
+          auto forceCmd = _ecm.Component<components::JointForceCmd>(_entity);
+          auto velocityCmd =
+              _ecm.Component<components::JointVelocityCmd>(_entity);
+
+          if (posReset || velReset ||
+              (forceCmd && nonZero(forceCmd->Data())) ||
+              (velocityCmd && nonZero(velocityCmd->Data())))
+          {
+            this->WakeUp(_entity);
+          }
+        }
+
         // Reset the velocity
         if (velReset)
         {
@@ -1765,6 +2009,13 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
           {
             jointPhys->SetForce(i, force->Data()[i]);
           }
+
+          if (holdCommands)
+          {
+            this->heldCommands.jointForces.emplace_back(_entity,
+                std::vector<double>(force->Data().begin(),
+                                    force->Data().begin() + nDofs));
+          }
         }
         // Only set joint velocity if joint force is not set.
         // If both the cmd and reset components are found, cmd is ignored.
@@ -1806,10 +2057,121 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
           {
             jointVelFeature->SetVelocityCommand(i, velocityCmd[i]);
           }
+
+          if (holdCommands)
+          {
+            velocityCmd.resize(nDofs);
+            this->heldCommands.jointVelocities.emplace_back(
+                _entity, std::move(velocityCmd));
+          }
         }
 
         return true;
-      });
+      };
+
+  auto queueComp =
+      _ecm.Component<components::JointCommandQueue>(this->worldEntity);
+
+  // Without the queue, the commands of all the joints are processed
+  if (!queueComp || !queueComp->Data())
+  {
+    _ecm.Each<components::Joint, components::Name>(processJointCommands);
+  }
+  else
+  {
+    auto &queue = *queueComp->Data();
+
+    // The scenario APIs and systems enqueue the joints they command. Other
+    // systems write the commands directly in the ECM, and the ECM has to be
+    // searched for the joints with pending commands only if any of them was
+    // inserted. Resets are removed and force commands are zeroed after every
+    // step, so that only the joints commanded in this step are found.
+    // Velocity commands are processed also when zero, since they hold the
+    // joint velocity.
+    if (queue.externalWriters() || this->externalJointCommands)
+    {
+      _ecm.Each<components::Joint, components::JointPositionReset>(
+          [&](const Entity &_entity, const components::Joint *,
+              const components::JointPositionReset *) -> bool
+          {
+            queue.push(_entity);
+            return true;
+          });
+
+      _ecm.Each<components::Joint, components::JointVelocityReset>(
+          [&](const Entity &_entity, const components::Joint *,
+              const components::JointVelocityReset *) -> bool
+          {
+            queue.push(_entity);
+            return true;
+          });
+
+      _ecm.Each<components::Joint, components::JointForceCmd>(
+          [&](const Entity &_entity, const components::Joint *,
+              const components::JointForceCmd *_force) -> bool
+          {
+            const auto &force = _force->Data();
+            if (std::any_of(force.begin(), force.end(),
+                  [](const double _value) { return _value != 0.0; }))
+            {
+              queue.push(_entity);
+            }
+            return true;
+          });
+
+      _ecm.Each<components::Joint, components::JointVelocityCmd>(
+          [&](const Entity &_entity, const components::Joint *,
+              const components::JointVelocityCmd *) -> bool
+          {
+            queue.push(_entity);
+            return true;
+          });
+
+      // Joints of models that are out of battery or halted have to be
+      // processed even if they did not receive any command
+      for (const auto &[modelEntity, off] : this->entityOffMap)
+      {
+        if (off)
+        {
+          for (const auto &joint :
+               _ecm.ChildrenByComponents(modelEntity, components::Joint()))
+          {
+            queue.push(joint);
+          }
+        }
+      }
+
+      _ecm.Each<components::Model, components::HaltMotion>(
+          [&](const Entity &_entity, const components::Model *,
+              const components::HaltMotion *_haltMotion) -> bool
+          {
+            if (!_haltMotion->Data())
+              return true;
+
+            for (const auto &joint :
+                 _ecm.ChildrenByComponents(_entity, components::Joint()))
+            {
+              queue.push(joint);
+            }
+            return true;
+          });
+    }
+
+    for (const auto &joint : queue.joints())
+    {
+      // The joint could have been removed after being enqueued
+      auto nameComp = _ecm.Component<components::Name>(joint);
+      if (!nameComp || !_ecm.EntityHasComponentType(
+              joint, components::Joint::typeId))
+      {
+        continue;
+      }
+
+      processJointCommands(joint, nullptr, nameComp);
+    }
+
+    queue.clear();
+  }
 
   // Link wrenches
   _ecm.Each<components::ExternalWorldWrenchCmd>(
@@ -1846,6 +2208,15 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
         linkForceFeature->AddExternalForce(math::eigen3::convert(force));
         linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
 
+        if (sleepingEnabled && (force != math::Vector3d::Zero ||
+                                torque != math::Vector3d::Zero))
+        {
+          this->WakeUp(_entity);
+        }
+
+        if (holdCommands)
+          this->heldCommands.linkWrenches.emplace_back(_entity, force, torque);
+
         return true;
       });
 
@@ -1894,6 +2265,12 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
       linkForceFeature->AddExternalForce(math::eigen3::convert(force));
       linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
 
+      if (sleepingEnabled)
+        this->WakeUp(_entity);
+
+      if (holdCommands)
+        this->heldCommands.linkWrenches.emplace_back(_entity, force, torque);
+
       // NOTE: Cleaning could be moved to UpdateSim, but let's
       //       keep things all together for now
       auto simTimeAfterStep = _info.simTime;
@@ -1946,6 +2323,9 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
         freeGroup->SetWorldPose(math::eigen3::convert(_poseCmd->Data() *
                                 linkPose));
 
+        if (sleepingEnabled)
+          this->WakeUp(_entity);
+
         // Process pose commands for static models here, as one-time changes
         if (this->staticEntities.find(_entity) != this->staticEntities.end())
         {
@@ -2028,6 +2408,9 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
           return true;
         this->entityFreeGroupMap.AddEntity(_entity, freeGroup);
 
+        if (sleepingEnabled && _angularVelocityCmd->Data() != math::Vector3d::Zero)
+          this->WakeUp(_entity);
+
         const components::Pose *poseComp =
             _ecm.Component<components::Pose>(_entity);
         math::Vector3d worldAngularVel = poseComp->Data().Rot() *
@@ -2079,6 +2462,9 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
 
         this->entityFreeGroupMap.AddEntity(_entity, freeGroup);
 
+        if (sleepingEnabled && _linearVelocityCmd->Data() != math::Vector3d::Zero)
+          this->WakeUp(_entity);
+
         const components::Pose *poseComp =
             _ecm.Component<components::Pose>(_entity);
         math::Vector3d worldLinearVel = poseComp->Data().Rot() *
@@ -2128,6 +2514,9 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
           return true;
         this->entityFreeGroupMap.AddEntity(_entity, freeGroup);
 
+        if (sleepingEnabled && _angularVelocityCmd->Data() != math::Vector3d::Zero)
+          this->WakeUp(_entity);
+
         auto worldAngularVelFeature =
             this->entityFreeGroupMap
                 .EntityCast<WorldVelocityCommandFeatureList>(_entity);
@@ -2180,6 +2569,9 @@ void PhysicsPrivate::UpdatePhysics(EntityComponentManager &_ecm,
           return true;
         this->entityFreeGroupMap.AddEntity(_entity, freeGroup);
 
+        if (sleepingEnabled && _linearVelocityCmd->Data() != math::Vector3d::Zero)
+          this->WakeUp(_entity);
+
         auto worldLinearVelFeature =
             this->entityFreeGroupMap
                 .EntityCast<WorldVelocityCommandFeatureList>(_entity);
@@ -2274,6 +2666,97 @@ ignition::physics::ForwardStep::Output PhysicsPrivate::Step(
   return output;
 }
 
+//////////////////////////////////////////////////
+ignition::physics::ForwardStep::Output PhysicsPrivate::StepWithSubsteps(
+    const std::chrono::steady_clock::duration &_dt)
+{
+  if (this->substeps <= 1)
+    return this->Step(_dt);
+
+  IGN_PROFILE("PhysicsPrivate::StepWithSubsteps");
+
+  // The last sub-step also includes the remainder of the division
+  const auto substepDt = _dt / static_cast<int64_t>(this->substeps);
+  const auto lastSubstepDt =
+      _dt - substepDt * static_cast<int64_t>(this->substeps - 1);
+
+  ignition::physics::ForwardStep::Output output;
+  std::vector<ignition::physics::WorldPose> changedPoses;
+  std::unordered_set<std::size_t> changedBodies;
+  bool reportsChangedPoses = false;
+
+  for (std::size_t i = 0; i < this->substeps; ++i)
+  {
+    // The engine clears the commands after each step
+    if (i > 0)
+      this->ReapplyHeldCommands();
+
+    output = this->Step(i + 1 < this->substeps ? substepDt : lastSubstepDt);
+
+    // Links that moved in any of the sub-steps have to be updated, even if
+    // they did not move in the last one
+    if (output.Has<ignition::physics::ChangedWorldPoses>())
+    {
+      reportsChangedPoses = true;
+
+      for (const auto &entry :
+          output.Query<ignition::physics::ChangedWorldPoses>()->entries)
+      {
+        if (changedBodies.insert(entry.body).second)
+          changedPoses.push_back(entry);
+      }
+    }
+  }
+
+  if (reportsChangedPoses)
+  {
+    output.Get<ignition::physics::ChangedWorldPoses>().entries =
+        std::move(changedPoses);
+  }
+
+  this->heldCommands.Clear();
+  return output;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::ReapplyHeldCommands()
+{
+  IGN_PROFILE("PhysicsPrivate::ReapplyHeldCommands");
+
+  for (const auto &[entity, forces] : this->heldCommands.jointForces)
+  {
+    auto jointPhys = this->entityJointMap.Get(entity);
+    if (nullptr == jointPhys)
+      continue;
+
+    for (std::size_t i = 0; i < forces.size(); ++i)
+      jointPhys->SetForce(i, forces[i]);
+  }
+
+  for (const auto &[entity, velocities] : this->heldCommands.jointVelocities)
+  {
+    auto jointVelFeature =
+        this->entityJointMap.EntityCast<JointVelocityCommandFeatureList>(
+            entity);
+    if (!jointVelFeature)
+      continue;
+
+    for (std::size_t i = 0; i < velocities.size(); ++i)
+      jointVelFeature->SetVelocityCommand(i, velocities[i]);
+  }
+
+  for (const auto &[entity, force, torque] : this->heldCommands.linkWrenches)
+  {
+    auto linkForceFeature =
+        this->entityLinkMap.EntityCast<LinkForceFeatureList>(entity);
+    if (!linkForceFeature)
+      continue;
+
+    linkForceFeature->AddExternalForce(math::eigen3::convert(force));
+    linkForceFeature->AddExternalTorque(math::eigen3::convert(torque));
+  }
+}
+
 //////////////////////////////////////////////////
 ignition::math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
   const Entity &_to, const EntityComponentManager &_ecm) const
@@ -2311,13 +2794,35 @@ ignition::math::Pose3d PhysicsPrivate::RelativePose(const Entity &_from,
 }
 
 //////////////////////////////////////////////////
-std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
+ChangedLinkBuffer &PhysicsPrivate::ChangedLinks(
     EntityComponentManager &_ecm,
     const ignition::physics::ForwardStep::Output &_updatedLinks)
 {
   IGN_PROFILE("Links Frame Data");
 
-  std::map<Entity, physics::FrameData3d> linkFrameData;
+  // Assign a slot to the new links and clear the buffer of the last step
+  this->canonicalLinkModelTracker.AddNewLinks(_ecm);
+  auto &linkFrameData = this->changedLinks;
+  linkFrameData.Reset(this->canonicalLinkModelTracker);
+
+  // When sleeping is enabled, the moved links are first collected in order
+  // to detect which models are at rest, and only the links of the awake
+  // models are stored in the buffer
+  const bool sleepingEnabled = this->SleepingEnabled();
+  this->movedLinks.clear();
+
+  auto setLink = [&](const Entity _link,
+                     const physics::FrameData3d &_frameData)
+  {
+    if (sleepingEnabled)
+    {
+      this->movedLinks.emplace_back(_link, _frameData);
+      return;
+    }
+
+    linkFrameData.Set(this->canonicalLinkModelTracker.LinkSlot(_link),
+        _link, _frameData);
+  };
 
   // Check to see if the physics engine gave a list of changed poses. If not, we
   // will iterate through all of the links via the ECM to see which ones changed
@@ -2342,8 +2847,7 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
         continue;
       }
 
-      auto frameData = linkPhys->FrameDataRelativeToWorld();
-      linkFrameData[entity] = frameData;
+      setLink(entity, linkPhys->FrameDataRelativeToWorld());
     }
   }
   else
@@ -2372,24 +2876,142 @@ std::map<Entity, physics::FrameData3d> PhysicsPrivate::ChangedLinks(
         if ((this->linkWorldPoses.find(_entity) == this->linkWorldPoses.end())
             || !this->pose3Eql(this->linkWorldPoses[_entity], worldPoseMath3d))
         {
-          // cache the updated link pose to check if the link pose has changed
-          // during the next iteration
-          this->linkWorldPoses[_entity] = worldPoseMath3d;
+          // The links of sleeping models are still passed along, so that the
+          // models moved by the engine wake up. Their cached pose is the one
+          // last written to the ECM, which is updated once they wake up.
+          if (!(sleepingEnabled && this->IsSleeping(_entity)))
+          {
+            // cache the updated link pose to check if the link pose has
+            // changed during the next iteration
+            this->linkWorldPoses[_entity] = worldPoseMath3d;
+          }
 
-          linkFrameData[_entity] = frameData;
+          setLink(_entity, frameData);
         }
 
         return true;
       });
   }
 
+  if (!sleepingEnabled)
+    return linkFrameData;
+
+  // Mark as active the models having at least one link moving faster than
+  // the threshold. Newly seen models start active.
+  for (const auto &[link, frameData] : this->movedLinks)
+  {
+    auto modelIt = this->topLevelModelMap.find(link);
+    if (modelIt == this->topLevelModelMap.end())
+      continue;
+
+    auto [lastActiveIt, inserted] =
+        this->modelLastActive.try_emplace(modelIt->second, this->iteration);
+
+    if (!inserted &&
+        (frameData.linearVelocity.norm() > this->sleepVelocityThreshold ||
+         frameData.angularVelocity.norm() > this->sleepVelocityThreshold))
+    {
+      lastActiveIt->second = this->iteration;
+    }
+  }
+
+  // Store only the links of the awake models
+  for (const auto &[link, frameData] : this->movedLinks)
+  {
+    if (this->IsSleeping(link))
+      continue;
+
+    linkFrameData.Set(this->canonicalLinkModelTracker.LinkSlot(link),
+        link, frameData);
+  }
+
   return linkFrameData;
 }
 
+//////////////////////////////////////////////////
+bool PhysicsPrivate::SleepingEnabled() const
+{
+  return this->sleepVelocityThreshold > 0.0;
+}
+
+//////////////////////////////////////////////////
+bool PhysicsPrivate::IsSleeping(const Entity _entity) const
+{
+  if (!this->SleepingEnabled())
+    return false;
+
+  auto modelIt = this->topLevelModelMap.find(_entity);
+  if (modelIt == this->topLevelModelMap.end())
+    return false;
+
+  auto lastActiveIt = this->modelLastActive.find(modelIt->second);
+  if (lastActiveIt == this->modelLastActive.end())
+    return false;
+
+  return this->iteration >= lastActiveIt->second + this->sleepSteps;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::WakeUp(const Entity _entity)
+{
+  auto modelIt = this->topLevelModelMap.find(_entity);
+  if (modelIt == this->topLevelModelMap.end())
+    return;
+
+  this->modelLastActive[modelIt->second] = this->iteration;
+}
+
+//////////////////////////////////////////////////
+void PhysicsPrivate::WakeUpOnContacts()
+{
+  IGN_PROFILE("PhysicsPrivate::WakeUpOnContacts");
+
+  if (!this->entityWorldMap.HasEntity(this->worldEntity))
+    return;
+
+  auto worldCollisionFeature =
+      this->entityWorldMap.EntityCast<CollisionFeatureList>(this->worldEntity);
+  if (!worldCollisionFeature)
+    return;
+
+  // A model resting on a static model, like the ground plane, keeps
+  // sleeping. It is woken up only if touched by a model that is awake.
+  auto isAwakeAndDynamic = [&](const Entity _model)
+  {
+    return this->staticEntities.find(_model) == this->staticEntities.end()
+        && !this->IsSleeping(_model);
+  };
+
+  for (const auto &contactComposite :
+       worldCollisionFeature->GetContactsFromLastStep())
+  {
+    const auto &contact = contactComposite.Get<WorldShapeType::ContactPoint>();
+
+    const auto model1It = this->topLevelModelMap.find(
+        this->entityCollisionMap.Get(ShapePtrType(contact.collision1)));
+    const auto model2It = this->topLevelModelMap.find(
+        this->entityCollisionMap.Get(ShapePtrType(contact.collision2)));
+
+    if (model1It == this->topLevelModelMap.end() ||
+        model2It == this->topLevelModelMap.end())
+    {
+      continue;
+    }
+
+    const Entity model1 = model1It->second;
+    const Entity model2 = model2It->second;
+
+    if (this->IsSleeping(model1) && isAwakeAndDynamic(model2))
+      this->WakeUp(model1);
+    else if (this->IsSleeping(model2) && isAwakeAndDynamic(model1))
+      this->WakeUp(model2);
+  }
+}
+
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateModelPose(const Entity _model,
     const Entity _canonicalLink, EntityComponentManager &_ecm,
-    std::map<Entity, physics::FrameData3d> &_linkFrameData)
+    ChangedLinkBuffer &_linkFrameData)
 {
   std::optional<math::Pose3d> parentWorldPose;
 
@@ -2428,7 +3050,8 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   // And X_WM is calculated from X_WL, which is obtained from physics as:
   //   X_WM = X_WL * (X_ML)^-1
   auto linkPoseFromModel = this->RelativePose(_model, _canonicalLink, _ecm);
-  const auto &linkWorldPose = _linkFrameData[_canonicalLink].pose;
+  const auto &linkWorldPose = _linkFrameData.FrameData(
+      this->canonicalLinkModelTracker.LinkSlot(_canonicalLink)).pose;
   const auto &modelWorldPose =
       math::eigen3::convert(linkWorldPose) * linkPoseFromModel.Inverse();
 
@@ -2458,14 +3081,16 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
   for (const auto &childLink : model.Links(_ecm))
   {
     // skip links that are already marked as a link to be updated
-    if (_linkFrameData.find(childLink) != _linkFrameData.end())
+    const auto childLinkSlot =
+        this->canonicalLinkModelTracker.LinkSlot(childLink);
+    if (_linkFrameData.Contains(childLinkSlot))
       continue;
 
     physics::FrameData3d childLinkFrameData;
     if (!this->GetFrameDataRelativeToWorld(childLink, childLinkFrameData))
       continue;
 
-    _linkFrameData[childLink] = childLinkFrameData;
+    _linkFrameData.Set(childLinkSlot, childLink, childLinkFrameData);
   }
 
   // since nested model poses are saved w.r.t. the nested model's parent
@@ -2484,10 +3109,12 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
     }
 
     auto nestedCanonicalLink = nestedModelCanonicalLinkComp->Data();
+    const auto nestedCanonicalLinkSlot =
+        this->canonicalLinkModelTracker.LinkSlot(nestedCanonicalLink);
 
     // skip links that are already marked as a link to be updated
     if (nestedCanonicalLink == _canonicalLink ||
-        _linkFrameData.find(nestedCanonicalLink) != _linkFrameData.end())
+        _linkFrameData.Contains(nestedCanonicalLinkSlot))
       continue;
 
     // mark this canonical link as one that needs to be updated so that all of
@@ -2497,7 +3124,8 @@ void PhysicsPrivate::UpdateModelPose(const Entity _model,
           canonicalLinkFrameData))
       continue;
 
-    _linkFrameData[nestedCanonicalLink] = canonicalLinkFrameData;
+    _linkFrameData.Set(nestedCanonicalLinkSlot, nestedCanonicalLink,
+        canonicalLinkFrameData);
   }
 }
 
@@ -2519,7 +3147,7 @@ bool PhysicsPrivate::GetFrameDataRelativeToWorld(const Entity _entity,
 
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
-    std::map<Entity, physics::FrameData3d> &_linkFrameData,
+    ChangedLinkBuffer &_linkFrameData,
     const ignition::gazebo::UpdateInfo &_info)
 {
   IGN_PROFILE("PhysicsPrivate::UpdateSim");
@@ -2565,20 +3193,23 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   // make sure we have an up-to-date mapping of canonical links to their models
   this->canonicalLinkModelTracker.AddNewModels(_ecm);
 
-  for (const auto &[linkEntity, frameData] : _linkFrameData)
+  std::size_t linkSlot;
+  while (_linkFrameData.PopNext(linkSlot))
   {
+    const Entity linkEntity = _linkFrameData.Link(linkSlot);
+
     // get a topological ordering of the models that have linkEntity as the
     // model's canonical link. If linkEntity isn't a canonical link for any
     // models, canonicalLinkModels will be empty
-    auto canonicalLinkModels =
+    const auto &canonicalLinkModels =
       this->canonicalLinkModelTracker.CanonicalLinkModels(linkEntity);
 
     // Update poses for all of the models that have this changed canonical link
     // (linkEntity). Since we have the models in topological order and
-    // _linkFrameData stores links in topological order thanks to the ordering
-    // of std::map (entity IDs are created in ascending order), this should
-    // properly handle pose updates for nested models that share the same
-    // canonical link.
+    // _linkFrameData visits links in topological order (entity IDs are created
+    // in ascending order), this should properly handle pose updates for nested
+    // models that share the same canonical link. Links added to _linkFrameData
+    // by UpdateModelPose are visited as well.
     //
     // Nested models that don't share the same canonical link will also need to
     // be updated since these nested models have their pose saved w.r.t. their
@@ -2591,8 +3222,11 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
 
   // Link poses, velocities...
   IGN_PROFILE_BEGIN("Links");
-  for (const auto &[entity, frameData] : _linkFrameData)
+  for (const auto slot : _linkFrameData.Slots())
   {
+    const Entity entity = _linkFrameData.Link(slot);
+    const auto &frameData = _linkFrameData.FrameData(slot);
+
     IGN_PROFILE_BEGIN("Local pose");
     auto canonicalLink =
         _ecm.Component<components::CanonicalLink>(entity);
@@ -2756,36 +3390,101 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
   }
   IGN_PROFILE_END();
 
-  // history of applied joint forces (commands)
-  _ecm.Each<components::Joint,
-            components::JointForceCmd,
-            components::HistoryOfAppliedJointForces>(
-       [&](const Entity& /*_entity*/,
-           components::Joint* /*_joint*/,
-           components::JointForceCmd* _forceCmd,
-           components::HistoryOfAppliedJointForces* _history) -> bool
-  {
-      // Since the operation is an append, we have to perform it only when
-      // the physics step is actually performed
-      if (_info.paused)
+  // History of the joint signals. Since the operation is an append, we have
+  // to perform it only when the physics step is actually performed.
+  if (!_info.paused)
+  {
+    IGN_PROFILE_BEGIN("Joint history");
+    using JointSignal = scenario::gazebo::JointSignal;
+
+    std::vector<double> row;
+    std::vector<double> paddedRow;
+
+    _ecm.Each<components::Joint, components::JointHistory>(
+        [&](const Entity &_entity,
+            components::Joint *,
+            components::JointHistory *_history) -> bool
+    {
+      auto &history = _history->Data();
+
+      // Append a row of values to the history of a signal, if enabled.
+      // The values are pushed in bulk without intermediate copies.
+      auto pushRow = [&](const JointSignal _signal,
+                         const std::vector<double> &_values)
       {
-          return true;
+        auto *buffer = history.buffer(_signal);
+        if (!buffer)
+          return;
+
+        if (_values.size() == buffer->width())
+        {
+          buffer->push(_values);
+          return;
+        }
+
+        // Signals not yet populated are recorded as zero
+        paddedRow.assign(buffer->width(), 0.0);
+        std::copy_n(_values.begin(),
+                    std::min(_values.size(), paddedRow.size()),
+                    paddedRow.begin());
+        buffer->push(paddedRow);
+      };
+
+      // Commanded forces, not yet cleared at this point of the update.
+      // Joints without a force command are not recorded.
+      if (history.enabled(JointSignal::AppliedForce))
+      {
+        auto *forceCmd = _ecm.Component<components::JointForceCmd>(_entity);
+        if (forceCmd)
+          pushRow(JointSignal::AppliedForce, forceCmd->Data());
       }
 
-      // Get the history queue
-      auto& history = _history->Data();
+      // The state is read from the physics engine since the joint components
+      // are updated later in this step
+      if (history.enabled(JointSignal::Position) ||
+          history.enabled(JointSignal::Velocity))
+      {
+        auto jointPhys = this->entityJointMap.Get(_entity);
+        const std::size_t dofs = jointPhys ?
+            jointPhys->GetDegreesOfFreedom() : 0;
+
+        if (history.enabled(JointSignal::Position))
+        {
+          row.resize(dofs);
+          for (std::size_t i = 0; i < dofs; ++i)
+            row[i] = jointPhys->GetPosition(i);
+          pushRow(JointSignal::Position, row);
+        }
+
+        if (history.enabled(JointSignal::Velocity))
+        {
+          row.resize(dofs);
+          for (std::size_t i = 0; i < dofs; ++i)
+            row[i] = jointPhys->GetVelocity(i);
+          pushRow(JointSignal::Velocity, row);
+        }
+      }
 
-      // Get the data from the component
-      auto jointForceCmdData = _forceCmd->Data();
+      if (history.enabled(JointSignal::PositionTarget))
+      {
+        auto *target =
+            _ecm.Component<components::JointPositionTarget>(_entity);
+        pushRow(JointSignal::PositionTarget,
+                target ? target->Data() : std::vector<double>{});
+      }
 
-      // Append values to the queue
-      for (const auto& jointForceCmd : jointForceCmdData)
+      if (history.enabled(JointSignal::VelocityTarget))
       {
-        history.push(jointForceCmd);
+        auto *target =
+            _ecm.Component<components::JointVelocityTarget>(_entity);
+        pushRow(JointSignal::VelocityTarget,
+                target ? target->Data() : std::vector<double>{});
       }
 
       return true;
-  });
+    });
+    IGN_PROFILE_END();
+  }
 
   // pose/velocity/acceleration of non-link entities such as sensors /
   // collisions. These get updated only if another system has created a
@@ -2963,76 +3662,218 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
         return true;
       });
 
-  // Update joint positions
+  // Update the joint state
   IGN_PROFILE_BEGIN("Joints");
-  _ecm.Each<components::Joint, components::JointPosition>(
-      [&](const Entity &_entity, components::Joint *,
-          components::JointPosition *_jointPos) -> bool
+
+  // The joint state caches can be created on existing models, therefore
+  // they are compared with those referenced by the flat array of joints
+  std::size_t numberOfCaches = 0;
+  bool cachesChanged = false;
+
+  _ecm.Each<components::Model, components::JointStateCache>(
+      [&](const Entity &_entity, const components::Model *,
+          components::JointStateCache *_cacheComp) -> bool
       {
-        if (auto jointPhys = this->entityJointMap.Get(_entity))
+        auto *cache = _cacheComp->Data().get();
+        if (!cache)
+          return true;
+
+        cachesChanged = cachesChanged ||
+            numberOfCaches >= this->jointStateCaches.size() ||
+            this->jointStateCaches[numberOfCaches].first != _entity ||
+            this->jointStateCaches[numberOfCaches].second != cache;
+
+        ++numberOfCaches;
+        return true;
+      });
+
+  cachesChanged =
+      cachesChanged || numberOfCaches != this->jointStateCaches.size();
+
+  // Rebuild the flat array of joints only if entities were created or
+  // removed, or if the joint state caches changed
+  if (this->jointWriteBackDirty || cachesChanged || _ecm.HasNewEntities() ||
+      _ecm.HasEntitiesMarkedForRemoval())
+  {
+    this->jointWriteBack.clear();
+    this->jointStateCaches.clear();
+
+    // Range of each joint in the buffers of the cache of its model
+    struct CacheRange
+    {
+      scenario::gazebo::utils::JointStateCache *cache;
+      std::size_t offset;
+      std::size_t dofs;
+    };
+    std::unordered_map<Entity, CacheRange> cacheRanges;
+
+    _ecm.Each<components::Model, components::JointStateCache>(
+        [&](const Entity &_entity, const components::Model *,
+            components::JointStateCache *_cacheComp) -> bool
         {
-          _jointPos->Data().resize(jointPhys->GetDegreesOfFreedom());
-          for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom();
-               ++i)
+          auto *cache = _cacheComp->Data().get();
+          if (!cache)
+            return true;
+
+          this->jointStateCaches.emplace_back(_entity, cache);
+
+          for (std::size_t j = 0; j < cache->joints.size(); ++j)
           {
-            _jointPos->Data()[i] = jointPhys->GetPosition(i);
+            cacheRanges[cache->joints[j]] = {cache, cache->offsets[j],
+                cache->offsets[j + 1] - cache->offsets[j]};
           }
-          _ecm.SetChanged(_entity, components::JointPosition::typeId,
-              ComponentState::PeriodicChange);
-        }
-        return true;
-      });
+          return true;
+        });
 
-  // Update joint Velocities
-  _ecm.Each<components::Joint, components::JointVelocity>(
-      [&](const Entity &_entity, components::Joint *,
-          components::JointVelocity *_jointVel) -> bool
-      {
-        if (auto jointPhys = this->entityJointMap.Get(_entity))
+    _ecm.Each<components::Joint>(
+        [&](const Entity &_entity, const components::Joint *) -> bool
         {
-          _jointVel->Data().resize(jointPhys->GetDegreesOfFreedom());
-          for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom();
-               ++i)
+          auto jointPhys = this->entityJointMap.Get(_entity);
+          if (!jointPhys)
+            return true;
+
+          auto modelIt = this->topLevelModelMap.find(_entity);
+
+          JointWriteBack entry{_entity, jointPhys,
+              jointPhys->GetDegreesOfFreedom(),
+              modelIt != this->topLevelModelMap.end() ?
+                  modelIt->second : kNullEntity};
+
+          if (auto rangeIt = cacheRanges.find(_entity);
+              rangeIt != cacheRanges.end())
           {
-            _jointVel->Data()[i] = jointPhys->GetVelocity(i);
+            entry.cache = rangeIt->second.cache;
+            entry.cacheOffset = rangeIt->second.offset;
+            entry.cacheDofs = std::min(entry.dofs, rangeIt->second.dofs);
           }
-        }
-        return true;
-      });
 
-  // Update joint accelerations
-  _ecm.Each<components::Joint, components::JointAcceleration>(
-      [&](const Entity& _entity,
-          components::Joint*,
-          components::JointAcceleration* _jointAcc) -> bool
+          this->jointWriteBack.push_back(entry);
+          return true;
+        });
+
+    this->jointWriteBackDirty = false;
+  }
+
+  // Write position, velocity, acceleration, and force of each joint in a
+  // single pass, both in the components and in the joint state cache of its
+  // model.
+  const bool sleepingEnabled = this->SleepingEnabled();
+
+  auto resize = [](auto *_component, const std::size_t _size)
+  {
+    if (_component && _component->Data().size() != _size)
+      _component->Data().resize(_size);
+  };
+
+  for (const auto &entry : this->jointWriteBack)
   {
-    if (auto jointPhys = this->entityJointMap.Get(_entity))
+    // The state of sleeping models is not written back, and their cache keeps
+    // the state they fell asleep with. Models are tracked from the first time
+    // their joints are processed, so that also models that never moved can
+    // fall asleep.
+    bool sleeping = false;
+
+    if (sleepingEnabled)
     {
-      _jointAcc->Data().resize(jointPhys->GetDegreesOfFreedom());
-      for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom(); ++i)
-      {
-        _jointAcc->Data()[i] = jointPhys->GetAcceleration(i);
-      }
+      this->modelLastActive.try_emplace(entry.model, this->iteration);
+      sleeping = this->IsSleeping(entry.model);
+
+      if (sleeping && (!entry.cache || entry.cache->populated))
+        continue;
     }
-    return true;
-  });
 
-  // Update joint forces
-  _ecm.Each<components::Joint, components::JointForce>(
-      [&](const Entity& _entity,
-          components::Joint*,
-          components::JointForce* _jointForce) -> bool
-  {
-    if (auto jointPhys = this->entityJointMap.Get(_entity))
+    // The state components are looked up at every step, since they can be
+    // created at any time by the scenario APIs or by other systems
+    const auto &jointPhys = entry.jointPhys;
+    auto *position = sleeping ? nullptr :
+        _ecm.Component<components::JointPosition>(entry.entity);
+    auto *velocity = sleeping ? nullptr :
+        _ecm.Component<components::JointVelocity>(entry.entity);
+    auto *acceleration = sleeping ? nullptr :
+        _ecm.Component<components::JointAcceleration>(entry.entity);
+    auto *force = sleeping ? nullptr :
+        _ecm.Component<components::JointForce>(entry.entity);
+
+    resize(position, entry.dofs);
+    resize(velocity, entry.dofs);
+    resize(acceleration, entry.dofs);
+    resize(force, entry.dofs);
+
+    for (std::size_t i = 0; i < entry.dofs; ++i)
     {
-      _jointForce->Data().resize(jointPhys->GetDegreesOfFreedom());
-      for (std::size_t i = 0; i < jointPhys->GetDegreesOfFreedom(); ++i)
+      const double q = jointPhys->GetPosition(i);
+      const double dq = jointPhys->GetVelocity(i);
+      const double ddq = jointPhys->GetAcceleration(i);
+      const double tau = jointPhys->GetForce(i);
+
+      if (position)
+        position->Data()[i] = q;
+      if (velocity)
+        velocity->Data()[i] = dq;
+      if (acceleration)
+        acceleration->Data()[i] = ddq;
+      if (force)
+        force->Data()[i] = tau;
+
+      if (entry.cache && i < entry.cacheDofs)
       {
-          _jointForce->Data()[i] = jointPhys->GetForce(i);
+        entry.cache->positions[entry.cacheOffset + i] = q;
+        entry.cache->velocities[entry.cacheOffset + i] = dq;
+        entry.cache->accelerations[entry.cacheOffset + i] = ddq;
+        entry.cache->forces[entry.cacheOffset + i] = tau;
       }
     }
-    return true;
-  });
+
+    if (position)
+    {
+      _ecm.SetChanged(entry.entity, components::JointPosition::typeId,
+          ComponentState::PeriodicChange);
+    }
+  }
+
+  // Mark the caches refreshed by this step
+  for (const auto &[modelEntity, cache] : this->jointStateCaches)
+  {
+    if (cache->populated && sleepingEnabled && this->IsSleeping(modelEntity))
+      continue;
+
+    cache->iteration = _info.iterations;
+    cache->populated = true;
+  }
+
+  // Record the joint trajectory of the models at every physics step, so that
+  // the state of all the steps of a run is available after it
+  if (!_info.paused &&
+      _ecm.HasComponentType(components::JointTrajectoryBuffer::typeId))
+  {
+    const double time =
+        std::chrono::duration<double>(_info.simTime).count();
+
+    _ecm.Each<components::Model, components::JointStateCache,
+              components::JointTrajectoryBuffer>(
+        [&](const Entity &_entity,
+            components::Model *,
+            components::JointStateCache *_cacheComp,
+            components::JointTrajectoryBuffer *_bufferComp) -> bool
+    {
+      const auto &cache = _cacheComp->Data();
+      auto &buffer = _bufferComp->Data();
+
+      if (!cache || cache->dofs() != buffer.dofs)
+        return true;
+
+      // The world pose of the models moved by the last step is already known
+      const auto poseIt = this->modelWorldPoses.find(_entity);
+      const math::Pose3d pose = poseIt != this->modelWorldPoses.end() ?
+          poseIt->second : worldPose(_entity, _ecm);
+
+      buffer.push(time, *cache,
+                  {pose.Pos().X(), pose.Pos().Y(), pose.Pos().Z(),
+                   pose.Rot().W(), pose.Rot().X(), pose.Rot().Y(),
+                   pose.Rot().Z()});
+      return true;
+    });
+  }
 
   IGN_PROFILE_END();
 
@@ -3076,17 +3917,25 @@ void PhysicsPrivate::UpdateSim(EntityComponentManager &_ecm,
         return true;
       });
 
+  // Wake up the sleeping models touched by awake ones before processing the
+  // contacts, so that they are not skipped
+  if (sleepingEnabled)
+    this->WakeUpOnContacts();
+
   // TODO(louise) Skip this if there are no collision features
   this->UpdateCollisions(_ecm);
+  this->AccumulateContacts(_ecm, _info);
 }
 
 //////////////////////////////////////////////////
 void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
 {
   IGN_PROFILE("PhysicsPrivate::UpdateCollisions");
-  // Quit early if the ContactData component hasn't been created. This means
-  // there are no systems that need contact information
-  if (!_ecm.HasComponentType(components::ContactSensorData::typeId))
+  // Quit early if neither the ContactData nor the ContactBuffer components
+  // have been created. This means there are no systems that need contact
+  // information
+  if (!_ecm.HasComponentType(components::ContactSensorData::typeId) &&
+      !_ecm.HasComponentType(components::ContactBuffer::typeId))
     return;
 
   // TODO(addisu) If systems are assumed to only have one world, we should
@@ -3106,9 +3955,19 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
     return false;
   });
 
-  // Quit early if the ContactData component was created and then removed.
+  bool hasContactBuffer = false;
+  _ecm.Each<components::ContactBuffer, components::Collision>(
+      [&](const Entity&,
+          components::ContactBuffer*,
+          components::Collision*) -> bool
+  {
+    hasContactBuffer = true;
+    return false;
+  });
+
+  // Quit early if the components were created and then removed.
   // This means there are no systems that need contact information.
-  if (!hasContactSensorData)
+  if (!hasContactSensorData && !hasContactBuffer)
     return;
 
   if (worldEntity == kNullEntity)
@@ -3158,10 +4017,132 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
   // create msgs::Contact objects conveniently later on.
   std::unordered_map<Entity, EntityContactMap> entityContactMap;
 
+  // The whitelist of the contacts to report, if any
+  const scenario::gazebo::utils::ContactFilter *contactFilter = nullptr;
+  auto contactFilterComp =
+      _ecm.Component<components::ContactFilter>(worldEntity);
+  if (contactFilterComp && contactFilterComp->Data() &&
+      !contactFilterComp->Data()->empty())
+  {
+    contactFilter = contactFilterComp->Data().get();
+  }
+
+  // Check if the contact of a collision with another one has to be stored in
+  // the contact buffers. Contacts are reported if the link of the collision
+  // is not filtered, or if the other collision belongs to one of the allowed
+  // links or models. The bodies of the collisions are cached when they are
+  // created, avoiding to walk the entity graph for each contact point.
+  auto isReported = [&](const Entity _collision, const Entity _other) -> bool
+  {
+    if (!contactFilter)
+      return true;
+
+    const auto collisionIt = this->collisionBodies.find(_collision);
+    if (collisionIt == this->collisionBodies.end() ||
+        collisionIt->second.empty())
+    {
+      return true;
+    }
+
+    const auto *allowed = contactFilter->allowed(collisionIt->second.front());
+    if (!allowed)
+      return true;
+
+    const auto otherIt = this->collisionBodies.find(_other);
+    if (otherIt == this->collisionBodies.end())
+      return false;
+
+    for (const Entity body : otherIt->second)
+    {
+      if (allowed->find(body) != allowed->end())
+        return true;
+    }
+
+    return false;
+  };
+
   // Note that we are temporarily storing pointers to elements in this
   // ("allContacts") container. Thus, we must make sure it doesn't get destroyed
   // until the end of this function.
   auto allContacts = worldCollisionFeature->GetContactsFromLastStep();
+
+  // Fill the plain contact buffers directly from the contacts of the engine
+  if (hasContactBuffer)
+  {
+    // Clear the contacts of the last step, keeping the storage. The
+    // collisions of sleeping models keep the contacts they fell asleep with.
+    _ecm.Each<components::Collision, components::ContactBuffer>(
+        [&](const Entity &_entity, components::Collision *,
+            components::ContactBuffer *_buffer) -> bool
+        {
+          if (!this->IsSleeping(_entity))
+            _buffer->Data().clear();
+          return true;
+        });
+
+    for (const auto &contactComposite : allContacts)
+    {
+      const auto &contact =
+          contactComposite.Get<WorldShapeType::ContactPoint>();
+      const auto* extraContactData =
+          contactComposite.Query<WorldShapeType::ExtraContactData>();
+
+      const Entity coll1Entity =
+        this->entityCollisionMap.Get(ShapePtrType(contact.collision1));
+      const Entity coll2Entity =
+        this->entityCollisionMap.Get(ShapePtrType(contact.collision2));
+
+      if (coll1Entity == kNullEntity || coll2Entity == kNullEntity)
+        continue;
+
+      // Discard the contacts not requested by any of the two collisions
+      const bool reported1 = isReported(coll1Entity, coll2Entity);
+      const bool reported2 = isReported(coll2Entity, coll1Entity);
+      if (!reported1 && !reported2)
+        continue;
+
+      // The force and the normal of the ExtraContactData refer to the first
+      // collision, and they are flipped for the second one
+      auto addPoint = [&](const Entity _collision, const Entity _other,
+                          const double _sign)
+      {
+        if (this->IsSleeping(_collision))
+          return;
+
+        auto buffer = _ecm.Component<components::ContactBuffer>(_collision);
+        if (!buffer)
+          return;
+
+        scenario::gazebo::utils::ContactPointData point;
+        point.collision = _collision;
+        point.otherCollision = _other;
+        point.position = {contact.point.x(), contact.point.y(),
+                          contact.point.z()};
+
+        if (extraContactData)
+        {
+          point.depth = extraContactData->depth;
+          for (std::size_t i = 0; i < 3; ++i)
+          {
+            point.normal[i] = _sign * extraContactData->normal[i];
+            point.force[i] = _sign * extraContactData->force[i];
+          }
+        }
+
+        buffer->Data().push_back(point);
+      };
+
+      if (reported1)
+        addPoint(coll1Entity, coll2Entity, 1.0);
+      if (reported2)
+        addPoint(coll2Entity, coll1Entity, -1.0);
+    }
+  }
+
+  // Quit if no system needs the contacts as messages
+  if (!hasContactSensorData)
+    return;
+
   for (const auto &contactComposite : allContacts)
   {
     // Get the RequireData
@@ -3301,6 +4282,54 @@ void PhysicsPrivate::UpdateCollisions(EntityComponentManager &_ecm)
       });
 }
 
+//////////////////////////////////////////////////
+void PhysicsPrivate::AccumulateContacts(EntityComponentManager &_ecm,
+    const ignition::gazebo::UpdateInfo &_info)
+{
+  IGN_PROFILE("PhysicsPrivate::AccumulateContacts");
+
+  // Contacts are accumulated only over the steps actually executed
+  if (_info.paused ||
+      !_ecm.HasComponentType(components::ContactAccumulator::typeId))
+  {
+    return;
+  }
+
+  // Enabling the accumulation also enables the contact buffers of the link
+  // collisions, which at this point contain the contacts of the last step.
+  // The collisions of sleeping models keep the contacts they fell asleep
+  // with, that are not accumulated again.
+  _ecm.Each<components::Collision, components::ContactBuffer,
+            components::ParentEntity>(
+      [&](const Entity &_entity, components::Collision *,
+          components::ContactBuffer *_buffer,
+          components::ParentEntity *_parent) -> bool
+      {
+        if (_buffer->Data().empty() || this->IsSleeping(_entity))
+          return true;
+
+        auto accumulator =
+            _ecm.Component<components::ContactAccumulator>(_parent->Data());
+        if (!accumulator)
+          return true;
+
+        for (const auto &point : _buffer->Data())
+          accumulator->Data().addPoint(point.force);
+
+        return true;
+      });
+
+  const double dt = std::chrono::duration<double>(_info.dt).count();
+
+  _ecm.Each<components::Link, components::ContactAccumulator>(
+      [&](const Entity &, components::Link *,
+          components::ContactAccumulator *_accumulator) -> bool
+      {
+        _accumulator->Data().endStep(dt);
+        return true;
+      });
+}
+
 physics::FrameData3d PhysicsPrivate::LinkFrameDataAtOffset(
       const LinkPtrType &_link, const math::Pose3d &_pose) const
 {
@@ -65,6 +65,42 @@ namespace systems
 
   /// \class Physics Physics.hh ignition/gazebo/systems/Physics.hh
   /// \brief Base class for a System.
+  ///
+  /// ## System Parameters
+  ///
+  /// - `<substeps>`: Number of physics engine steps executed in each update
+  ///   of the system (default: 1). The duration of the update is split among
+  ///   the steps, therefore the world step size should be set to `substeps`
+  ///   times the desired resolution of the physics engine. The ECM is read
+  ///   before the first step and written after the last one, avoiding the
+  ///   cost of the intermediate updates. Joint force and velocity commands
+  ///   and link wrenches are held constant for all the steps.
+  ///
+  ///   The ECM does not observe the intermediate steps:
+  ///   * Link and model poses and velocities, joint states, the joint state
+  ///     caches and the contacts refer to the last step.
+  ///   * Joint histories, recorded trajectories and accumulated contacts
+  ///     store a single sample per update, taken after the last step.
+  ///   * Systems and controllers run once per update, and wrenches with
+  ///     duration expire with the resolution of the update.
+  ///
+  /// - `<sleep_velocity_threshold>`: Linear and angular velocity of the
+  ///   links below which a top-level model is considered at rest (default: 0,
+  ///   disabled). Models at rest for `<sleep_steps>` consecutive steps
+  ///   (default: 100) fall asleep, and the ECM updates of their link poses
+  ///   and velocities, joint states, joint state caches and contact buffers
+  ///   are skipped, and their contacts are not accumulated. The physics
+  ///   engine keeps simulating sleeping models.
+  ///   They wake up when they receive a non-zero joint command, wrench or
+  ///   velocity command, a pose or joint reset, or when an awake model
+  ///   touches them. Removing a model wakes up all the models.
+  ///
+  /// - `<external_joint_commands>`: Whether systems that do not enqueue the
+  ///   joints they command write joint commands in the ECM (default: false).
+  ///   When the world has a joint command queue, the ECM is searched for the
+  ///   joints with pending commands only if this parameter is set or if such
+  ///   systems were inserted through scenario, either as plugins or in the
+  ///   SDF of the world and its models.
   class Physics:
     public System,
     public ISystemConfigure,
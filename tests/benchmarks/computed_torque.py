@@ -0,0 +1,118 @@
+# Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT). All rights reserved.
+# This software may be modified and distributed under the terms of the
+# GNU Lesser General Public License v2.1 or any later version.
+
+"""
+Benchmark of the caching of the dynamics in the ComputedTorqueFixedBase controller.
+
+It steps fixed-base serial chains with an increasing number of DoFs controlled
+by the computed torque controller at the physics rate, and reports the average
+cost of a simulation step. The mass matrix and the bias forces are recomputed
+either at every step or with the periods of the cached configurations.
+
+Usage: python tests/benchmarks/computed_torque.py
+"""
+
+import tempfile
+import time
+
+from gym_ignition.context.gazebo import controllers
+
+from scenario import core
+from scenario import gazebo as scenario
+
+STEP_SIZE = 0.001
+NUMBER_OF_STEPS = 2000
+NUMBER_OF_DOFS = [2, 8, 16, 32]
+
+# Recomputation periods of the mass matrix and the bias forces
+DYNAMICS_PERIODS = [(0.0, 0.0), (0.01, 0.0), (0.01, 0.005)]
+
+
+def chain_urdf(dofs: int) -> str:
+
+    link = """
+    <link name="link{idx}">
+        <inertial>
+            <origin xyz="0 0 0.05"/>
+            <mass value="0.5"/>
+            <inertia ixx="0.001" ixy="0" ixz="0" iyy="0.001" iyz="0" izz="0.0005"/>
+        </inertial>
+    </link>
+    <joint name="joint{idx}" type="revolute">
+        <parent link="{parent}"/>
+        <child link="link{idx}"/>
+        <origin xyz="0 0 {offset}"/>
+        <axis xyz="{axis}"/>
+        <limit lower="-3.14" upper="3.14" effort="1000" velocity="100"/>
+    </joint>
+    """
+
+    links = [
+        link.format(
+            idx=idx,
+            parent="world" if idx == 0 else f"link{idx - 1}",
+            offset=0.0 if idx == 0 else 0.1,
+            axis="0 1 0" if idx % 2 == 0 else "1 0 0",
+        )
+        for idx in range(dofs)
+    ]
+
+    return f'<robot name="chain"><link name="world"/>{"".join(links)}</robot>'
+
+
+def benchmark(dofs: int, mass_matrix_period: float, bias_forces_period: float) -> float:
+
+    gazebo = scenario.GazeboSimulator(STEP_SIZE, 1.0, 1)
+    assert gazebo.initialize()
+
+    world = gazebo.get_world().to_gazebo()
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    with tempfile.NamedTemporaryFile(mode="w", suffix=".urdf", delete=False) as f:
+        f.write(chain_urdf(dofs))
+        urdf = f.name
+
+    assert world.insert_model(urdf, core.Pose_identity(), "chain")
+    model = world.get_model("chain").to_gazebo()
+
+    assert model.set_controller_period(STEP_SIZE)
+    assert model.insert_model_plugin(
+        *controllers.ComputedTorqueFixedBase(
+            kp=[100.0] * dofs,
+            ki=[0.0] * dofs,
+            kd=[10.0] * dofs,
+            urdf=urdf,
+            joints=model.joint_names(),
+            mass_matrix_period=mass_matrix_period,
+            bias_forces_period=bias_forces_period,
+        ).args()
+    )
+
+    assert model.set_joint_position_targets([0.1] * dofs)
+    assert model.set_joint_velocity_targets([0.0] * dofs)
+    assert model.set_joint_acceleration_targets([0.0] * dofs)
+
+    assert gazebo.run(paused=True)
+
+    start = time.perf_counter()
+
+    for _ in range(NUMBER_OF_STEPS):
+        assert gazebo.run()
+
+    elapsed = time.perf_counter() - start
+    gazebo.close()
+
+    return elapsed / NUMBER_OF_STEPS * 1e6
+
+
+if __name__ == "__main__":
+
+    scenario.set_verbosity(scenario.Verbosity_warning)
+
+    header = [f"M {m}s h {h}s" for m, h in DYNAMICS_PERIODS]
+    print(f"{'dofs':>6} " + " ".join(f"{h:>20}" for h in header) + "  (us/step)")
+
+    for dofs in NUMBER_OF_DOFS:
+        costs = [benchmark(dofs, *periods) for periods in DYNAMICS_PERIODS]
+        print(f"{dofs:>6} " + " ".join(f"{c:>20.1f}" for c in costs))
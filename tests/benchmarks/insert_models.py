@@ -0,0 +1,94 @@
+# Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT). All rights reserved.
+# This software may be modified and distributed under the terms of the
+# GNU Lesser General Public License v2.1 or any later version.
+
+"""
+Benchmark of the insertion of many models in a world.
+
+It compares the insertion of the models one at a time with the batched
+World.insert_models, reporting the average insertion time per model.
+
+Usage: python tests/benchmarks/insert_models.py
+"""
+
+import time
+from typing import Callable, List
+
+from gym_ignition.utils import misc
+
+from scenario import core
+from scenario import gazebo as scenario
+
+NUMBER_OF_MODELS = [10, 100, 1000]
+
+SPHERE_URDF = """
+<robot name="sphere">
+    <link name="sphere">
+        <inertial>
+            <mass value="1.0"/>
+            <inertia ixx="0.004" ixy="0" ixz="0" iyy="0.004" iyz="0" izz="0.004"/>
+        </inertial>
+        <collision>
+            <geometry>
+                <sphere radius="0.1"/>
+            </geometry>
+        </collision>
+    </link>
+</robot>
+"""
+
+
+def pose(idx: int) -> core.Pose:
+
+    return core.Pose([idx % 32, idx // 32, 0.1], [1, 0, 0, 0])
+
+
+def insert_serial(world: scenario.World, model_file: str, n: int) -> None:
+
+    for idx in range(n):
+        assert world.insert_model(model_file, pose(idx), f"sphere{idx}")
+
+
+def insert_batched(world: scenario.World, model_file: str, n: int) -> None:
+
+    specs: List[scenario.ModelSpec] = []
+
+    for idx in range(n):
+        spec = scenario.ModelSpec()
+        spec.source = model_file
+        spec.pose = pose(idx)
+        spec.name = f"sphere{idx}"
+        specs.append(spec)
+
+    assert world.insert_models(specs)
+
+
+def benchmark(insert: Callable[[scenario.World, str, int], None], n: int) -> float:
+
+    gazebo = scenario.GazeboSimulator(0.001, 1.0, 1)
+    assert gazebo.initialize()
+
+    world = gazebo.get_world().to_gazebo()
+    model_file = misc.string_to_file(SPHERE_URDF)
+
+    start = time.perf_counter()
+    insert(world, model_file, n)
+    assert gazebo.run(paused=True)
+    elapsed = time.perf_counter() - start
+
+    assert len(world.model_names()) == n
+    gazebo.close()
+
+    return elapsed
+
+
+if __name__ == "__main__":
+
+    scenario.set_verbosity(scenario.Verbosity_warning)
+
+    print(f"{'models':>8} {'serial [ms/model]':>20} {'batched [ms/model]':>20}")
+
+    for n in NUMBER_OF_MODELS:
+        serial = benchmark(insert_serial, n)
+        batched = benchmark(insert_batched, n)
+        print(f"{n:>8} {1000 * serial / n:>20.3f} {1000 * batched / n:>20.3f}")
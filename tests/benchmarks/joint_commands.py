@@ -0,0 +1,73 @@
+# Copyright (C) 2020 Istituto Italiano di Tecnologia (IIT). All rights reserved.
+# This software may be modified and distributed under the terms of the
+# GNU Lesser General Public License v2.1 or any later version.
+
+"""
+Benchmark of the processing of the joint commands in the Physics system.
+
+It steps a world with many pendulums, only a fraction of which receives a
+force command at every step, and reports the achieved steps per second.
+Only the commanded joints are processed by the Physics system, therefore the
+throughput should not degrade with the number of passive joints.
+
+Usage: python tests/benchmarks/joint_commands.py
+"""
+
+import time
+
+import gym_ignition_models
+
+from scenario import core
+from scenario import gazebo as scenario
+
+NUMBER_OF_MODELS = 100
+NUMBER_OF_STEPS = 2000
+COMMANDED_FRACTIONS = [0.0, 0.01, 0.1, 1.0]
+
+
+def benchmark(commanded_fraction: float) -> float:
+
+    gazebo = scenario.GazeboSimulator(0.001, 1.0, 1)
+    assert gazebo.initialize()
+
+    world = gazebo.get_world().to_gazebo()
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    model_file = gym_ignition_models.get_model_file("pendulum")
+
+    for idx in range(NUMBER_OF_MODELS):
+        pose = core.Pose([idx % 10, idx // 10, 0], [1, 0, 0, 0])
+        assert world.insert_model(model_file, pose, f"pendulum{idx}")
+
+    assert gazebo.run(paused=True)
+
+    commanded = []
+
+    for idx in range(int(commanded_fraction * NUMBER_OF_MODELS)):
+        joint = world.get_model(f"pendulum{idx}").get_joint("pivot")
+        assert joint.set_control_mode(core.JointControlMode_force)
+        commanded.append(joint)
+
+    start = time.perf_counter()
+
+    for _ in range(NUMBER_OF_STEPS):
+        for joint in commanded:
+            assert joint.set_generalized_force_target(0.1)
+
+        assert gazebo.run()
+
+    elapsed = time.perf_counter() - start
+    gazebo.close()
+
+    return NUMBER_OF_STEPS / elapsed
+
+
+if __name__ == "__main__":
+
+    scenario.set_verbosity(scenario.Verbosity_warning)
+
+    print(f"{'commanded models':>18} {'steps/sec':>12}")
+
+    for fraction in COMMANDED_FRACTIONS:
+        steps_per_second = benchmark(fraction)
+        print(f"{int(fraction * NUMBER_OF_MODELS):>18} {steps_per_second:>12.1f}")
@@ -248,3 +248,165 @@ def test_cube_multiple_contacts(
             for point in contact.points:
                 assert point.force[2] > 0
                 assert point.normal == pytest.approx([0, 0, 1], abs=0.001)
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_contact_filter(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+    world = gazebo.get_world().to_gazebo()
+
+    # Insert the Physics system
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    # Insert the ground plane
+    assert world.insert_model(gym_ignition_models.get_model_file("ground_plane"))
+
+    # Insert two cubes side to side with a 10cm gap and a third one above the gap
+    cube_urdf = misc.string_to_file(utils.get_cube_urdf_string())
+    assert world.insert_model(
+        cube_urdf, core.Pose([0, -0.15, 0.101], [1.0, 0, 0, 0]), "cube1"
+    )
+    assert world.insert_model(
+        cube_urdf, core.Pose([0, 0.15, 0.101], [1.0, 0, 0, 0]), "cube2"
+    )
+    assert world.insert_model(
+        cube_urdf, core.Pose([0, 0, 0.301], [1.0, 0, 0, 0]), "cube3"
+    )
+
+    cube2 = world.get_model("cube2").to_gazebo()
+    cube3 = world.get_model("cube3").to_gazebo()
+
+    assert cube2.enable_contacts(enable=True)
+    assert cube3.enable_contacts(enable=True)
+
+    # Unknown bodies are rejected
+    assert not cube3.set_contact_filter(["cube4"])
+    assert not cube3.set_contact_filter(["cube1::link"])
+
+    # Report only the contacts of cube3 with cube1, and of cube2 with the ground
+    assert cube3.set_contact_filter(["cube1"])
+    assert cube2.get_link("cube").to_gazebo().set_contact_filter(
+        ["ground_plane::link"]
+    )
+
+    # Make the cubes fall
+    for _ in range(300):
+        gazebo.run()
+
+    assert len(cube3.contacts()) == 1
+    assert cube3.contacts()[0].body_b == "cube1::cube"
+
+    assert len(cube2.contacts()) == 1
+    assert cube2.contacts()[0].body_b == "ground_plane::link"
+
+    # Removing the filter reports again all the contacts
+    assert cube3.set_contact_filter([])
+    gazebo.run()
+    assert len(cube3.contacts()) == 2
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 10)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_contact_accumulation(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+    world = gazebo.get_world().to_gazebo()
+
+    # Insert the Physics system
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    # Insert the ground plane
+    assert world.insert_model(gym_ignition_models.get_model_file("ground_plane"))
+
+    # Insert a cube slightly above the ground
+    cube_urdf = misc.string_to_file(utils.get_cube_urdf_string())
+    assert world.insert_model(cube_urdf, core.Pose([0, 0, 0.15], [1.0, 0, 0, 0]))
+    gazebo.run(paused=True)
+
+    cube = world.get_model("cube_robot").to_gazebo()
+    cube_link = cube.get_link("cube").to_gazebo()
+
+    # The statistics are not available before enabling the accumulation
+    with pytest.raises(RuntimeError):
+        cube_link.contact_statistics()
+
+    assert cube.enable_contact_accumulation(enable=True)
+    assert cube_link.contact_accumulation_enabled()
+    assert cube_link.contacts_enabled()
+
+    # The cube is in the air during the first run
+    gazebo.run()
+    statistics = cube_link.contact_statistics()
+    assert statistics.steps == 10
+    assert statistics.steps_in_contact == 0
+    assert statistics.max_force == 0.0
+
+    # Let the cube fall and settle on the ground
+    for _ in range(100):
+        gazebo.run()
+
+    # The statistics refer only to the steps of the last run
+    statistics = cube.contact_statistics()[0]
+    assert statistics.steps == 10
+    assert statistics.steps_in_contact == 10
+    assert statistics.num_of_contact_points >= 10
+
+    # The contact force balances the weight of the cube
+    weight = cube.total_mass() * 9.8
+    dt = gazebo.step_size() * statistics.steps
+    assert statistics.mean_force[2] == pytest.approx(weight, rel=0.05)
+    assert statistics.impulse[2] == pytest.approx(weight * dt, rel=0.05)
+    assert statistics.max_force >= statistics.mean_force[2]
+
+    # Paused runs do not reset the statistics
+    gazebo.run(paused=True)
+    assert cube_link.contact_statistics().steps == 10
+
+    assert cube.enable_contact_accumulation(enable=False)
+    assert not cube_link.contact_accumulation_enabled()
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 10)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_contact_accumulation_sleeping_model(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+    world = gazebo.get_world().to_gazebo()
+
+    # Insert the Physics system with the detection of the models at rest
+    context = (
+        "<sdf version='1.7'>"
+        "<sleep_velocity_threshold>0.01</sleep_velocity_threshold>"
+        "<sleep_steps>50</sleep_steps>"
+        "</sdf>"
+    )
+    assert world.insert_world_plugin(
+        "PhysicsSystem", "scenario::plugins::gazebo::Physics", context
+    )
+
+    # Insert the ground plane and a cube resting on it
+    assert world.insert_model(gym_ignition_models.get_model_file("ground_plane"))
+    cube_urdf = misc.string_to_file(utils.get_cube_urdf_string())
+    assert world.insert_model(cube_urdf, core.Pose([0, 0, 0.101], [1.0, 0, 0, 0]))
+    gazebo.run(paused=True)
+
+    cube = world.get_model("cube_robot").to_gazebo()
+    cube_link = cube.get_link("cube").to_gazebo()
+    assert cube.enable_contact_accumulation(enable=True)
+
+    # Let the cube settle on the ground long enough to fall asleep
+    for _ in range(100):
+        gazebo.run()
+
+    # The contacts the cube fell asleep with are not accumulated again
+    gazebo.run()
+    statistics = cube_link.contact_statistics()
+    assert statistics.steps == 10
+    assert statistics.steps_in_contact == 0
+    assert statistics.num_of_contact_points == 0
+    assert statistics.impulse == pytest.approx([0, 0, 0])
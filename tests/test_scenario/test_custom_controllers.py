@@ -23,7 +23,10 @@ scenario.set_verbosity(scenario.Verbosity_debug)
 @pytest.mark.parametrize(
     "gazebo", [(0.001, 5.0, 1)], indirect=True, ids=utils.id_gazebo_fn
 )
-def test_computed_torque_fixed_base(gazebo: scenario.GazeboSimulator):
+@pytest.mark.parametrize("dynamics_periods", [(0.0, 0.0), (0.01, 0.005)])
+def test_computed_torque_fixed_base(
+    gazebo: scenario.GazeboSimulator, dynamics_periods: tuple
+):
 
     assert gazebo.initialize()
     step_size = gazebo.step_size()
@@ -60,6 +63,8 @@ def test_computed_torque_fixed_base(gazebo: scenario.GazeboSimulator):
             kd=[3.0] * panda.dofs(),
             urdf=panda_urdf,
             joints=panda.joint_names(),
+            mass_matrix_period=dynamics_periods[0],
+            bias_forces_period=dynamics_periods[1],
         ).args()
     )
 
@@ -109,3 +114,215 @@ def test_computed_torque_fixed_base(gazebo: scenario.GazeboSimulator):
     assert panda.joint_velocities() == pytest.approx(
         panda.joint_velocity_targets(), abs=0.05
     )
+
+
+def insert_panda_with_computed_torque(
+    gazebo: scenario.GazeboSimulator, num_of_controllers: int = 1
+) -> scenario.Model:
+
+    assert gazebo.initialize()
+
+    world = gazebo.get_world()
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf, core.Pose_identity(), "panda")
+
+    panda = world.get_model("panda").to_gazebo()
+    panda.set_controller_period(gazebo.step_size())
+
+    # The statistics are not available without a controller
+    with pytest.raises(RuntimeError):
+        panda.controller_statistics()
+
+    for _ in range(num_of_controllers):
+        assert panda.insert_model_plugin(
+            *controllers.ComputedTorqueFixedBase(
+                kp=[10.0] * panda.dofs(),
+                ki=[0.0] * panda.dofs(),
+                kd=[3.0] * panda.dofs(),
+                urdf=panda_urdf,
+                joints=panda.joint_names(),
+            ).args()
+        )
+
+    assert panda.set_joint_position_targets([0.0] * panda.dofs())
+    assert panda.set_joint_velocity_targets([0.0] * panda.dofs())
+    assert panda.set_joint_acceleration_targets([0.0] * panda.dofs())
+
+    return panda
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 5.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_controller_statistics(gazebo: scenario.GazeboSimulator):
+
+    panda = insert_panda_with_computed_torque(gazebo)
+
+    for _ in range(1000):
+        assert gazebo.run()
+
+    # Check the timing statistics of the controller
+    statistics = panda.controller_statistics()
+    assert 0 < statistics.steps <= 1000
+    assert 0 < statistics.min_time <= statistics.mean_time <= statistics.max_time
+    assert statistics.min_time <= statistics.p99_time <= statistics.max_time
+    assert 0 <= statistics.overruns <= statistics.steps
+
+    # The controller runs at every step
+    steps = statistics.steps
+
+    for _ in range(100):
+        assert gazebo.run()
+
+    assert panda.controller_statistics().steps == steps + 100
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 5.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_controller_statistics_multiple_runners(gazebo: scenario.GazeboSimulator):
+
+    panda = insert_panda_with_computed_torque(gazebo, num_of_controllers=2)
+
+    for _ in range(1000):
+        assert gazebo.run()
+
+    steps = panda.controller_statistics().steps
+    assert steps > 0
+
+    # Only the first ControllerRunner records its steps, otherwise each step
+    # of the simulator would be counted twice
+    for _ in range(100):
+        assert gazebo.run()
+
+    assert panda.controller_statistics().steps == steps + 100
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 5.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_mlp_policy(gazebo: scenario.GazeboSimulator, tmp_path):
+
+    assert gazebo.initialize()
+    step_size = gazebo.step_size()
+
+    # Get the default world without gravity
+    world = gazebo.get_world()
+    assert world.set_gravity((0, 0, 0))
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    # Insert the panda arm
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf, core.Pose_identity(), "panda")
+    panda = world.get_model("panda").to_gazebo()
+
+    joints = [j for j in panda.joint_names() if j.startswith("panda_joint")]
+    n = len(joints)
+
+    # Build a network that computes the PD law tau = -kp * s - kd * ds.
+    # The hidden layer splits the law in its positive and negative parts with
+    # relu activations, and the output layer recombines them.
+    assert n == 7
+    kp = np.diag([50.0, 50.0, 30.0, 30.0, 10.0, 10.0, 5.0])
+    kd = np.diag([15.0, 15.0, 8.0, 8.0, 2.0, 2.0, 0.5])
+    gains = np.hstack([-kp, -kd])
+    weights_file = str(tmp_path / "pd.bin")
+
+    controllers.MLPPolicy.write_weights(
+        file=weights_file,
+        weights=[np.vstack([gains, -gains]), np.hstack([np.eye(n), -np.eye(n)])],
+        biases=[np.zeros(2 * n), np.zeros(n)],
+        activations=["relu", "linear"],
+    )
+
+    # Reset the joints state
+    q0 = [np.deg2rad(20)] * n
+    assert panda.reset_joint_positions(q0, joints)
+    assert gazebo.run(paused=True)
+
+    # Insert the policy
+    assert panda.set_controller_period(step_size)
+    assert panda.insert_model_plugin(
+        *controllers.MLPPolicy(weights=weights_file, joints=joints).args()
+    )
+
+    for j in joints:
+        assert panda.get_joint(j).control_mode() == core.JointControlMode_force
+
+    for _ in range(5000):
+        assert gazebo.run()
+
+    # Check that the policy regulated the joints to zero
+    assert panda.joint_positions(joints) == pytest.approx([0.0] * n, abs=np.deg2rad(1))
+    assert panda.joint_velocities(joints) == pytest.approx([0.0] * n, abs=0.05)
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 5.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_mlp_policy_position_output(gazebo: scenario.GazeboSimulator, tmp_path):
+
+    assert gazebo.initialize()
+    step_size = gazebo.step_size()
+
+    # Get the default world without gravity
+    world = gazebo.get_world()
+    assert world.set_gravity((0, 0, 0))
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    # Insert the panda arm
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf, core.Pose_identity(), "panda")
+    panda = world.get_model("panda").to_gazebo()
+
+    joints = [j for j in panda.joint_names() if j.startswith("panda_joint")]
+    n = len(joints)
+
+    # Build a network with a constant output of ones, that the action
+    # normalization maps to the desired joint positions
+    q_target = np.deg2rad([10.0, -10.0, 20.0, -20.0, 15.0, 30.0, -15.0])
+    weights_file = str(tmp_path / "constant.bin")
+
+    controllers.MLPPolicy.write_weights(
+        file=weights_file,
+        weights=[np.zeros((n, 2 * n))],
+        biases=[np.ones(n)],
+        activations=["linear"],
+    )
+
+    # Set the gains of the joint controller that tracks the position targets
+    gains = [(50, 0, 20), (10000, 0, 500), (100, 0, 10), (1000, 0, 50)] + [
+        (100, 0, 10)
+    ] * 3
+
+    for j, (kp, ki, kd) in zip(joints, gains):
+        assert panda.get_joint(j).set_pid(pid=core.PID(kp, ki, kd))
+
+    # Insert the policy running slower than the physics
+    assert panda.set_controller_period(10 * step_size)
+    assert panda.insert_model_plugin(
+        *controllers.MLPPolicy(
+            weights=weights_file,
+            joints=joints,
+            output="position",
+            action_offset=list(q_target / 2),
+            action_scale=list(q_target / 2),
+        ).args()
+    )
+
+    for j in joints:
+        assert panda.get_joint(j).control_mode() == core.JointControlMode_position
+
+    assert gazebo.run()
+
+    # The action has been set as the position targets
+    assert panda.joint_position_targets(joints) == pytest.approx(q_target)
+
+    for _ in range(5000):
+        assert gazebo.run()
+
+    # Check that the joint controller tracked the targets
+    assert panda.joint_position_targets(joints) == pytest.approx(q_target)
+    assert panda.joint_positions(joints) == pytest.approx(q_target, abs=np.deg2rad(3))
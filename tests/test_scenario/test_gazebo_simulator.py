@@ -2,6 +2,9 @@
 # This software may be modified and distributed under the terms of the
 # GNU Lesser General Public License v2.1 or any later version.
 
+import threading
+import time
+
 import pytest
 
 pytestmark = pytest.mark.scenario
@@ -133,3 +136,35 @@ def test_load_default_world(gazebo: scenario.GazeboSimulator):
     # TODO: understand how to compare shared ptr returned by swig with nullptr
     # world3 = gazebo.get_world("foo")
     # assert world3
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 500)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_run_releases_gil(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+
+    ticks = []
+    stop = threading.Event()
+
+    def ticker():
+        while not stop.is_set():
+            ticks.append(time.perf_counter())
+            time.sleep(0.001)
+
+    thread = threading.Thread(target=ticker)
+    thread.start()
+
+    # With rtf=1 a single call of run() lasts ~0.5 s. If the GIL was held
+    # by the wrapper, the ticker thread could not progress during the call.
+    try:
+        start = time.perf_counter()
+        assert gazebo.run()
+        end = time.perf_counter()
+    finally:
+        stop.set()
+        thread.join()
+
+    assert end - start > 0.1
+    assert len([t for t in ticks if start < t < end]) > 10
@@ -117,6 +117,278 @@ def test_model_joints(gazebo: scenario.GazeboSimulator):
     )
 
 
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_model_joint_state_cache(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+
+    gym_ignition_model_name = "panda"
+    model = get_model(gazebo, gym_ignition_model_name)
+
+    assert model.reset_joint_positions([0.1] * model.dofs())
+    assert model.set_joint_control_mode(core.JointControlMode_force)
+    assert model.set_joint_generalized_force_targets([0.5] * model.dofs())
+
+    for _ in range(10):
+        gazebo.run()
+
+    # The vectorized getters with the default serialization are served from
+    # the cache refreshed by the physics system, and must match the state
+    # stored in the joint components
+    joints = model.joints()
+
+    assert model.joint_positions() == pytest.approx(
+        [j.position() for j in joints]
+    )
+    assert model.joint_velocities() == pytest.approx(
+        [j.velocity() for j in joints]
+    )
+    assert model.joint_accelerations() == pytest.approx(
+        [j.acceleration() for j in joints]
+    )
+    assert model.joint_generalized_forces() == pytest.approx(
+        [j.generalized_force() for j in joints]
+    )
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_model_joint_state_from_world_sdf(
+    gazebo: scenario.GazeboSimulator, tmp_path
+):
+
+    # A pendulum defined in the world file, whose entities are created before
+    # the resources of the scenario APIs
+    world_sdf_string = """<?xml version="1.0" ?>
+    <sdf version="1.7">
+        <world name="default">
+            <model name="pendulum">
+                <link name="base"/>
+                <link name="arm">
+                    <pose>0 0 -0.5 0 0 0</pose>
+                    <inertial>
+                        <pose>0 0 -0.5 0 0 0</pose>
+                        <mass>1</mass>
+                        <inertia>
+                            <ixx>0.01</ixx>
+                            <iyy>0.01</iyy>
+                            <izz>0.01</izz>
+                        </inertia>
+                    </inertial>
+                </link>
+                <joint name="fixed" type="fixed">
+                    <parent>world</parent>
+                    <child>base</child>
+                </joint>
+                <joint name="pivot" type="revolute">
+                    <pose>0 0 0.5 0 0 0</pose>
+                    <parent>base</parent>
+                    <child>arm</child>
+                    <axis>
+                        <xyz>0 1 0</xyz>
+                    </axis>
+                </joint>
+            </model>
+        </world>
+    </sdf>"""
+
+    world_sdf = tmp_path / "pendulum_world.sdf"
+    world_sdf.write_text(world_sdf_string)
+
+    assert gazebo.insert_world_from_sdf(str(world_sdf))
+    assert gazebo.initialize()
+
+    world = gazebo.get_world().to_gazebo()
+    assert world.set_physics_engine(scenario.PhysicsEngine_dart)
+
+    model = world.get_model("pendulum").to_gazebo()
+    joint = model.get_joint("pivot").to_gazebo()
+    view = np.asarray(model.joint_positions_buffer())
+
+    assert joint.reset_position(0.5)
+    assert gazebo.run(paused=True)
+
+    for _ in range(100):
+        assert gazebo.run()
+
+    # The pendulum swings and its state is written both in the joint
+    # components and in the joint state cache
+    assert joint.position() != pytest.approx(0.5)
+    assert joint.velocity() != pytest.approx(0.0)
+    assert model.joint_positions() == pytest.approx([joint.position()])
+    assert model.joint_velocities() == pytest.approx([joint.velocity()])
+    assert view == pytest.approx([joint.position()])
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 20)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_model_trajectory_recording(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+
+    model = get_model(gazebo, "panda")
+    dofs = model.dofs()
+
+    with pytest.raises(RuntimeError):
+        model.recorded_joint_positions()
+
+    assert not model.enable_trajectory_recording(enable=True, capacity=0)
+    assert model.enable_trajectory_recording(enable=True, capacity=50)
+    assert model.trajectory_recording_enabled()
+
+    assert model.reset_joint_positions([0.1] * dofs)
+    assert model.set_joint_control_mode(core.JointControlMode_force)
+
+    for _ in range(3):
+        assert gazebo.run()
+
+    # Only the physics steps of the last run are recorded
+    assert model.num_of_recorded_steps() == 20
+
+    times = np.array(model.recorded_times())
+    positions = np.array(model.recorded_joint_positions()).reshape(-1, dofs)
+    velocities = np.array(model.recorded_joint_velocities()).reshape(-1, dofs)
+    forces = np.array(model.recorded_joint_generalized_forces()).reshape(-1, dofs)
+    poses = np.array(model.recorded_base_poses()).reshape(-1, 7)
+
+    assert positions.shape == velocities.shape == forces.shape == (20, dofs)
+    assert poses.shape == (20, 7)
+
+    assert np.diff(times) == pytest.approx([gazebo.step_size()] * 19)
+    assert times[-1] == pytest.approx(gazebo.get_world().time())
+
+    # The last recorded step matches the current state of the model
+    assert positions[-1] == pytest.approx(model.joint_positions())
+    assert velocities[-1] == pytest.approx(model.joint_velocities())
+    assert poses[-1][0:3] == pytest.approx(model.base_position())
+
+    # The robot falls under gravity during the run
+    assert not np.allclose(positions[0], positions[-1])
+
+    # Paused runs do not clear the recorded data
+    assert gazebo.run(paused=True)
+    assert model.num_of_recorded_steps() == 20
+
+    # A smaller buffer keeps only the most recent steps
+    assert model.enable_trajectory_recording(enable=True, capacity=5)
+    assert gazebo.run()
+    assert model.num_of_recorded_steps() == 5
+    positions = np.array(model.recorded_joint_positions()).reshape(-1, dofs)
+    assert positions[-1] == pytest.approx(model.joint_positions())
+
+    assert model.enable_trajectory_recording(enable=False)
+    assert not model.trajectory_recording_enabled()
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_model_joint_selection(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+
+    gym_ignition_model_name = "panda"
+    model = get_model(gazebo, gym_ignition_model_name)
+
+    joint_subset = model.joint_names()[1:5]
+    selection = model.joint_selection(joint_subset)
+
+    assert selection.joint_names() == joint_subset
+    assert selection.dofs() == model.dofs(joint_subset)
+
+    assert model.reset_joint_positions([0.2] * selection.dofs(), selection)
+    assert model.reset_joint_velocities([-0.1] * selection.dofs(), selection)
+    gazebo.run(paused=True)
+
+    assert model.joint_positions(selection) == pytest.approx(
+        model.joint_positions(joint_subset)
+    )
+    assert model.joint_positions(selection) == pytest.approx(
+        [0.2] * selection.dofs()
+    )
+    assert model.joint_velocities(selection) == pytest.approx(
+        [-0.1] * selection.dofs()
+    )
+
+    assert model.set_joint_control_mode(core.JointControlMode_force)
+    assert model.set_joint_generalized_force_targets(
+        [1.5] * selection.dofs(), selection
+    )
+    assert model.joint_generalized_force_targets(selection) == pytest.approx(
+        [1.5] * selection.dofs()
+    )
+    assert model.joint_generalized_force_targets(joint_subset) == pytest.approx(
+        [1.5] * selection.dofs()
+    )
+
+    # Wrong size of the data
+    assert not model.set_joint_generalized_force_targets(
+        [1.5] * (selection.dofs() + 1), selection
+    )
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_model_numpy_buffers(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+
+    gym_ignition_model_name = "panda"
+    model = get_model(gazebo, gym_ignition_model_name)
+
+    # Inputs accept numpy arrays
+    q = np.linspace(-0.1, 0.1, model.dofs())
+    assert model.reset_joint_positions(q)
+    assert model.reset_base_position(np.array([0.0, 0.0, 1.0]))
+    gazebo.run(paused=True)
+
+    # Non-contiguous arrays fall back to the default conversion
+    assert model.reset_joint_velocities(np.zeros(2 * model.dofs())[::2])
+
+    # Outputs can be written into preallocated arrays
+    out = np.zeros(model.dofs())
+    model.joint_positions_into(out)
+    assert out == pytest.approx(q)
+    assert out == pytest.approx(model.joint_positions())
+
+    base_position = np.zeros(3)
+    model.base_position_into(base_position)
+    assert base_position == pytest.approx([0.0, 0.0, 1.0])
+
+    with pytest.raises(RuntimeError):
+        model.joint_positions_into(np.zeros(model.dofs() + 1))
+
+    with pytest.raises(RuntimeError):
+        model.joint_positions_into(np.zeros(model.dofs(), dtype=np.float32))
+
+    # The joint state cache is exposed without copies
+    view = np.asarray(model.joint_positions_buffer())
+    assert view.shape == (model.dofs(),)
+    assert not view.flags.writeable
+    assert view == pytest.approx(q)
+
+    gazebo.run()
+    assert view == pytest.approx(model.joint_positions())
+
+    # The views keep the cache alive after the model is removed
+    last_positions = np.array(model.joint_positions())
+    velocities = np.asarray(model.joint_velocities_buffer())
+    del model
+
+    world = gazebo.get_world().to_gazebo()
+    assert world.remove_model(gym_ignition_model_name)
+    gazebo.run(paused=True)
+    assert gym_ignition_model_name not in world.model_names()
+
+    assert view == pytest.approx(last_positions)
+    assert velocities.shape == last_positions.shape
+
+
 @pytest.mark.parametrize(
     "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
 )
@@ -313,3 +585,58 @@ def test_history_of_joint_forces(
         assert panda.history_of_applied_joint_forces() == pytest.approx(
             history_last_three_runs
         )
+
+
+@pytest.mark.parametrize("default_world", [(1.0 / 1_000, 1.0, 1)], indirect=True)
+def test_history_of_joint_signals(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert a panda model
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf)
+    panda = world.get_model("panda").to_gazebo()
+
+    # Record the positions and velocities of the last 5 steps
+    assert panda.enable_history(scenario.JointSignal_position, True, 5)
+    assert panda.enable_history(scenario.JointSignal_velocity, True, 5)
+    assert panda.history_enabled(scenario.JointSignal_position)
+    assert not panda.history_enabled(scenario.JointSignal_position_target)
+
+    # The history is initialized with zeros
+    assert panda.history(scenario.JointSignal_position) == pytest.approx(
+        np.zeros(panda.dofs() * 5)
+    )
+
+    positions = []
+
+    for _ in range(10):
+        gazebo.run()
+        positions.append(panda.joint_positions())
+
+    # The robot falls under gravity
+    history = np.array(panda.history(scenario.JointSignal_position))
+    assert history == pytest.approx(np.concatenate(positions[-5:]))
+
+    history = np.array(panda.history(scenario.JointSignal_velocity))
+    assert history[-panda.dofs() :] == pytest.approx(panda.joint_velocities())
+
+    # Enlarging the window keeps the recorded values
+    assert panda.enable_history(scenario.JointSignal_position, True, 8)
+    history = np.array(panda.history(scenario.JointSignal_position))
+    assert history[-panda.dofs() * 5 :] == pytest.approx(
+        np.concatenate(positions[-5:])
+    )
+    assert history[: panda.dofs() * 3] == pytest.approx(np.zeros(panda.dofs() * 3))
+
+    # The history of a single joint contains one value per step
+    joint = panda.get_joint(panda.joint_names()[0]).to_gazebo()
+    assert len(joint.history(scenario.JointSignal_velocity)) == 5
+
+    assert panda.enable_history(scenario.JointSignal_position, False)
+    assert not panda.history_enabled(scenario.JointSignal_position)
+    assert panda.history_enabled(scenario.JointSignal_velocity)
+    assert len(joint.history(scenario.JointSignal_position)) == 0
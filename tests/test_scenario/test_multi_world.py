@@ -6,11 +6,12 @@ import pytest
 
 pytestmark = pytest.mark.scenario
 
-# import gym_ignition_models
+import gym_ignition_models
+
 # import numpy as np
 # from gym_ignition.utils import misc
 
-# from scenario import core as scenario_core
+from scenario import core as scenario_core
 from scenario import gazebo as scenario_gazebo
 
 from ..common import utils
@@ -112,6 +113,113 @@ def test_insert_world_multiple_calls(gazebo: scenario_gazebo.GazeboSimulator):
     assert world1.id() != world2.id()
 
 
+def get_world_sdf_file(path, collision_detector: str) -> str:
+
+    world_sdf_string = f"""<?xml version="1.0" ?>
+    <sdf version="1.7">
+        <world name="default">
+            <physics default="true" type="dart">
+                <dart>
+                    <collision_detector>{collision_detector}</collision_detector>
+                </dart>
+            </physics>
+        </world>
+    </sdf>"""
+
+    world_sdf = path / f"world_{collision_detector}.sdf"
+    world_sdf.write_text(world_sdf_string)
+    return str(world_sdf)
+
+
+def simulate_falling_cubes(gazebo: scenario_gazebo.GazeboSimulator, runs: int):
+
+    models = []
+    cube_urdf = utils.get_cube_urdf()
+    ground_plane = gym_ignition_models.get_model_file("ground_plane")
+
+    for name in gazebo.world_names():
+        world = gazebo.get_world(name)
+        assert world.set_physics_engine(scenario_gazebo.PhysicsEngine_dart)
+        assert world.insert_model(ground_plane)
+        assert world.insert_model(
+            cube_urdf, scenario_core.Pose([0, 0, 0.3], [0.9659, 0.2588, 0, 0])
+        )
+        assert gazebo.run(paused=True)
+        models.append(world.get_model("cube_robot"))
+
+    for _ in range(runs):
+        assert gazebo.run()
+
+    return models
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 10)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_parallel_stepping(gazebo: scenario_gazebo.GazeboSimulator, tmp_path):
+
+    world_names = [f"world{idx}" for idx in range(4)]
+    empty_world_sdf = utils.get_empty_world_sdf()
+
+    for name in world_names:
+        assert gazebo.insert_world_from_sdf(empty_world_sdf, name)
+
+    assert gazebo.parallel_stepping_threads() == 0
+    assert gazebo.enable_parallel_stepping(2)
+    assert gazebo.parallel_stepping_threads() == 2
+
+    assert gazebo.initialize()
+    assert not gazebo.enable_parallel_stepping(4)
+    assert gazebo.parallel_stepping_threads() == 2
+
+    # The cubes fall on the ground and collide with it
+    models = simulate_falling_cubes(gazebo, runs=50)
+
+    # All the worlds advanced by the same number of steps
+    for name in world_names:
+        assert gazebo.get_world(name).time() == pytest.approx(0.5)
+
+    # The cubes landed on the ground
+    assert models[0].base_position()[2] == pytest.approx(0.1, abs=0.01)
+
+    # Worlds are independent and their evolution is deterministic
+    for model in models[1:]:
+        assert model.base_position() == models[0].base_position()
+        assert model.base_orientation() == models[0].base_orientation()
+
+    # Step the same world serially with the collision detector selected in
+    # the parallel mode
+    serial = scenario_gazebo.GazeboSimulator(0.001, 1.0, 10)
+    assert serial.insert_world_from_sdf(get_world_sdf_file(tmp_path, "bullet"))
+    assert serial.initialize()
+
+    [serial_model] = simulate_falling_cubes(serial, runs=50)
+
+    assert serial_model.base_position() == pytest.approx(
+        models[0].base_position()
+    )
+    assert serial_model.base_orientation() == pytest.approx(
+        models[0].base_orientation()
+    )
+
+    serial.close()
+
+
+def test_parallel_stepping_unsafe_collision_detector(tmp_path):
+
+    gazebo = scenario_gazebo.GazeboSimulator(0.001, 1.0, 1)
+    world_sdf = get_world_sdf_file(tmp_path, "ode")
+
+    assert gazebo.insert_world_from_sdf(world_sdf, "world1")
+    assert gazebo.insert_world_from_sdf(world_sdf, "world2")
+    assert gazebo.enable_parallel_stepping(2)
+
+    # ODE relies on global state and cannot be stepped concurrently
+    assert not gazebo.initialize()
+
+    gazebo.close()
+
+
 # # This test is flaky
 # @pytest.mark.xfail(strict=False)
 # @pytest.mark.parametrize("gazebo, solver",
@@ -126,3 +126,237 @@ def test_position_pid(default_world: Tuple[scenario.GazeboSimulator, scenario.Wo
         # Check that trajectory is being followed
         assert joint1.position() == pytest.approx(joint1_reference, abs=np.deg2rad(3))
         assert joint6.position() == pytest.approx(joint6_reference, abs=np.deg2rad(3))
+
+
+@pytest.mark.parametrize("default_world", [(1.0 / 1_000, 1.0, 1)], indirect=True)
+def test_mixed_control_modes(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert a panda model
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf)
+    assert "panda" in world.model_names()
+
+    # Get the model and cast it to Gazebo
+    panda = world.get_model("panda").to_gazebo()
+
+    # Disable any velocity and torque limits of the model
+    _ = [j.set_velocity_limit(np.finfo(float).max) for j in panda.joints()]
+    _ = [j.set_max_generalized_force(np.finfo(float).max) for j in panda.joints()]
+
+    # Set the controller period equal to the physics step (1000Hz)
+    assert gazebo.run(paused=True)
+    panda.set_controller_period(gazebo.step_size())
+
+    for joint_name, pid in panda_pid_gains_1000Hz.items():
+        assert panda.get_joint(joint_name).set_pid(pid=pid)
+
+    assert panda.set_joint_control_mode(core.JointControlMode_position)
+
+    for _ in range(500):
+        assert gazebo.run()
+
+    # Switch joint1 to velocity control, setting its PID after the switch
+    joint1 = panda.get_joint("panda_joint1").to_gazebo()
+    assert joint1.set_control_mode(core.JointControlMode_velocity)
+    assert joint1.set_pid(pid=core.PID(50, 0, 0))
+    assert joint1.set_velocity_target(0.5)
+
+    for _ in range(500):
+        assert gazebo.run()
+
+    # joint1 follows its velocity target while the others hold their position
+    assert joint1.velocity() == pytest.approx(0.5, abs=0.05)
+
+    for joint_name in set(panda.joint_names()) - {"panda_joint1"}:
+        joint = panda.get_joint(joint_name)
+        assert joint.position() == pytest.approx(
+            joint.position_target(), abs=np.deg2rad(1)
+        )
+
+
+@pytest.mark.parametrize("default_world", [(1.0 / 1_000, 1.0, 1)], indirect=True)
+def test_change_pid_preserves_other_joints(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert two identical panda models, one used as reference
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf, core.Pose_identity(), "panda")
+    assert world.insert_model(
+        panda_urdf, core.Pose([0, 2.0, 0], [1.0, 0, 0, 0]), "reference"
+    )
+
+    # Joint4 fights gravity with a large integral term
+    pid_gains = dict(panda_pid_gains_1000Hz)
+    pid_gains["panda_joint4"] = core.PID(1000, 500, 50)
+
+    assert gazebo.run(paused=True)
+    models = [world.get_model(name).to_gazebo() for name in ("panda", "reference")]
+
+    for model in models:
+        _ = [j.set_velocity_limit(np.finfo(float).max) for j in model.joints()]
+        _ = [j.set_max_generalized_force(np.finfo(float).max) for j in model.joints()]
+        model.set_controller_period(gazebo.step_size())
+
+        for joint_name, pid in pid_gains.items():
+            assert model.get_joint(joint_name).set_pid(pid=pid)
+
+        assert model.set_joint_control_mode(core.JointControlMode_position)
+
+    panda, reference = models
+
+    for _ in range(1_000):
+        assert gazebo.run()
+
+    # Setting the PID of joint1 resets only the state of its own PID
+    assert panda.get_joint("panda_joint1").set_pid(
+        pid=pid_gains["panda_joint1"]
+    )
+
+    for _ in range(10):
+        assert gazebo.run()
+
+        for joint_name in ("panda_joint4", "panda_joint7"):
+            joint = panda.get_joint(joint_name)
+            reference_joint = reference.get_joint(joint_name)
+            assert joint.generalized_force() == pytest.approx(
+                reference_joint.generalized_force(), rel=1e-3, abs=1e-6
+            )
+
+
+@pytest.mark.parametrize("default_world", [(1.0 / 1_000, 1.0, 1)], indirect=True)
+@pytest.mark.parametrize("reset", ["position", "velocity"])
+def test_reset_joint_resets_pid(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World], reset: str
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert two identical panda models, one used as reference
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf, core.Pose_identity(), "panda")
+    assert world.insert_model(
+        panda_urdf, core.Pose([0, 2.0, 0], [1.0, 0, 0, 0]), "reference"
+    )
+
+    # Joint4 fights gravity with a large integral term
+    pid_gains = dict(panda_pid_gains_1000Hz)
+    pid_gains["panda_joint4"] = core.PID(1000, 500, 50)
+
+    assert gazebo.run(paused=True)
+    models = [world.get_model(name).to_gazebo() for name in ("panda", "reference")]
+
+    for model in models:
+        _ = [j.set_velocity_limit(np.finfo(float).max) for j in model.joints()]
+        _ = [j.set_max_generalized_force(np.finfo(float).max) for j in model.joints()]
+        model.set_controller_period(gazebo.step_size())
+
+        for joint_name, pid in pid_gains.items():
+            assert model.get_joint(joint_name).set_pid(pid=pid)
+
+        assert model.set_joint_control_mode(core.JointControlMode_position)
+
+    panda, reference = models
+
+    # Build up the integral error
+    for _ in range(1_000):
+        assert gazebo.run()
+
+    # Reset joint4 to its current state, that only resets its PID. The PID of
+    # the reference is reset by setting it again.
+    joint4 = panda.get_joint("panda_joint4").to_gazebo()
+
+    if reset == "position":
+        assert joint4.reset_position(joint4.position())
+    else:
+        assert joint4.reset_velocity(joint4.velocity())
+
+    assert reference.get_joint("panda_joint4").set_pid(
+        pid=pid_gains["panda_joint4"]
+    )
+
+    # The commands after the reset do not contain the previous integral term
+    for _ in range(10):
+        assert gazebo.run()
+
+        assert joint4.generalized_force() == pytest.approx(
+            reference.get_joint("panda_joint4").generalized_force(),
+            rel=1e-3,
+            abs=1e-6,
+        )
+
+
+@pytest.mark.parametrize("default_world", [(1.0 / 1_000, 1.0, 1)], indirect=True)
+def test_position_interpolated(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert a panda model
+    panda_urdf = gym_ignition_models.get_model_file("panda")
+    assert world.insert_model(panda_urdf)
+    assert "panda" in world.model_names()
+
+    # Get the model and cast it to Gazebo
+    panda = world.get_model("panda").to_gazebo()
+
+    # Disable any velocity and torque limits of the model
+    _ = [j.set_velocity_limit(np.finfo(float).max) for j in panda.joints()]
+    _ = [j.set_max_generalized_force(np.finfo(float).max) for j in panda.joints()]
+
+    # Set the controller period equal to the physics step (1000Hz)
+    assert gazebo.run(paused=True)
+    panda.set_controller_period(gazebo.step_size())
+
+    for joint_name, pid in panda_pid_gains_1000Hz.items():
+        assert panda.get_joint(joint_name).set_pid(pid=pid)
+
+    # By default the targets are interpolated over the time between them
+    assert panda.interpolation_duration() == 0.0
+    assert not panda.set_interpolation_duration(-1.0)
+    assert panda.set_interpolation_duration(0.5)
+    assert panda.interpolation_duration() == pytest.approx(0.5)
+
+    assert panda.set_joint_control_mode(core.JointControlMode_position_interpolated)
+
+    for _ in range(100):
+        assert gazebo.run()
+
+    # Move joint1 with a single target
+    joint1 = panda.get_joint("panda_joint1").to_gazebo()
+    q0 = joint1.position()
+    assert joint1.set_position_target(q0 + 0.5)
+
+    # The joint moves smoothly towards the target
+    for _ in range(100):
+        assert gazebo.run()
+
+    assert q0 < joint1.position() < q0 + 0.25
+
+    # The target is reached at the end of the trajectory
+    for _ in range(900):
+        assert gazebo.run()
+
+    assert joint1.position() == pytest.approx(q0 + 0.5, abs=np.deg2rad(1))
+
+    # Targets sent at 50 Hz are tracked at the controller rate
+    assert panda.set_interpolation_duration(0.0)
+
+    for k in range(1, 51):
+        assert joint1.set_position_target(q0 + 0.5 - 0.01 * k)
+
+        for _ in range(20):
+            assert gazebo.run()
+
+    assert joint1.position() == pytest.approx(q0, abs=np.deg2rad(2))
@@ -2,14 +2,20 @@
 # This software may be modified and distributed under the terms of the
 # GNU Lesser General Public License v2.1 or any later version.
 
+from typing import Tuple
+
 import pytest
 
 pytestmark = pytest.mark.scenario
 
+import gym_ignition_models
+import numpy as np
+
 from scenario import core
 from scenario import gazebo as scenario
 
 from ..common import utils
+from ..common.utils import default_world_fixture as default_world
 from ..common.utils import gazebo_fixture as gazebo
 
 # Set the verbosity
@@ -220,3 +226,475 @@ def test_sim_time_starts_from_zero(gazebo: scenario.GazeboSimulator):
 
     gazebo.run(paused=False)
     assert world.time() == pytest.approx(3 * dt)
+
+
+@pytest.mark.parametrize(
+    "default_world", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_save_restore_state(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert a pendulum and a falling cube, rotated so that its body and world
+    # frames differ
+    pendulum_urdf = gym_ignition_models.get_model_file("pendulum")
+    assert world.insert_model(pendulum_urdf)
+    cube_pose = core.Pose([1.0, 0, 1.0], [0.9238795, 0.3826834, 0, 0])
+    assert world.insert_model(utils.get_cube_urdf(), cube_pose, "cube")
+    assert gazebo.run(paused=True)
+
+    pendulum = world.get_model("pendulum").to_gazebo()
+    cube = world.get_model("cube").to_gazebo()
+
+    assert pendulum.reset_joint_positions([0.5])
+    assert cube.reset_base_world_velocity([0.5, 0, 0], [0, 0, 1.0])
+    assert gazebo.run(paused=True)
+
+    for _ in range(10):
+        assert gazebo.run()
+
+    # Save the state
+    handle = world.save_state()
+    saved_positions = pendulum.joint_positions()
+    saved_velocities = pendulum.joint_velocities()
+    saved_cube_position = cube.base_position()
+    saved_cube_linear_velocity = cube.base_world_linear_velocity()
+    saved_cube_angular_velocity = cube.base_world_angular_velocity()
+    assert np.linalg.norm(saved_cube_angular_velocity) > 0.5
+
+    def trajectory():
+        states = []
+        for _ in range(50):
+            assert gazebo.run()
+            states.append(
+                pendulum.joint_positions()
+                + pendulum.joint_velocities()
+                + cube.base_position()
+                + cube.base_world_linear_velocity()
+                + cube.base_world_angular_velocity()
+            )
+        return states
+
+    trajectory1 = trajectory()
+    assert pendulum.joint_positions() != saved_positions
+    assert cube.base_position() != saved_cube_position
+
+    # The components are restored instantaneously
+    assert world.restore_state(handle)
+    assert pendulum.joint_positions() == pytest.approx(saved_positions)
+    assert pendulum.joint_velocities() == pytest.approx(saved_velocities)
+    assert cube.base_position() == pytest.approx(saved_cube_position)
+    assert cube.base_world_linear_velocity() == pytest.approx(
+        saved_cube_linear_velocity
+    )
+    assert cube.base_world_angular_velocity() == pytest.approx(
+        saved_cube_angular_velocity
+    )
+
+    # The physics is aligned in the next step and evolves from the saved state
+    trajectory2 = trajectory()
+    for p1, p2 in zip(trajectory1, trajectory2):
+        assert p1 == pytest.approx(p2, abs=1e-6)
+
+    # Handles can be removed
+    assert world.remove_state(handle)
+    assert not world.remove_state(handle)
+    assert not world.restore_state(handle)
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_model_registry(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+    world = gazebo.get_world().to_gazebo()
+
+    # Insert many models without stepping the simulator
+    cube_urdf_string = utils.get_cube_urdf_string()
+    names = [f"cube{idx}" for idx in range(100)]
+
+    for idx, name in enumerate(names):
+        assert world.insert_model_from_string(
+            cube_urdf_string, core.Pose([idx, 0, 0], [1, 0, 0, 0]), name
+        )
+
+    # Models are listed in insertion order and can be queried right away
+    assert list(world.model_names()) == names
+    assert world.get_model("cube42").base_position() == pytest.approx([42, 0, 0])
+
+    # The registry is kept in sync during the simulator steps
+    assert gazebo.run(paused=True)
+    assert list(world.model_names()) == names
+
+    # Removed models are listed until the removal is processed
+    assert world.remove_model("cube42")
+    assert "cube42" in world.model_names()
+    assert gazebo.run(paused=True)
+    assert "cube42" not in world.model_names()
+    assert len(world.model_names()) == 99
+
+    # The name of a removed model can be reused
+    assert world.insert_model_from_string(
+        cube_urdf_string, core.Pose_identity(), "cube42"
+    )
+    assert world.model_names()[-1] == "cube42"
+    assert gazebo.run(paused=True)
+    assert len(world.model_names()) == 100
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_insert_models(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+    world = gazebo.get_world().to_gazebo()
+
+    specs = []
+
+    for idx in range(20):
+        spec = scenario.ModelSpec()
+        spec.source = utils.get_cube_urdf_string()
+        spec.source_is_string = True
+        spec.pose = core.Pose([idx, 0, 0], [1, 0, 0, 0])
+        spec.name = f"cube{idx}"
+        specs.append(spec)
+
+    spec = scenario.ModelSpec()
+    spec.source = utils.get_cube_urdf()
+    specs.append(spec)
+
+    assert world.insert_models(specs)
+
+    default_model_name = scenario.get_model_name_from_sdf(utils.get_cube_urdf())
+    assert list(world.model_names()) == [f"cube{idx}" for idx in range(20)] + [
+        default_model_name
+    ]
+
+    assert world.get_model("cube7").base_position() == pytest.approx([7, 0, 0])
+    assert gazebo.run(paused=True)
+    assert world.get_model("cube7").base_position() == pytest.approx([7, 0, 0])
+
+    # Models with clashing names are not inserted
+    other = scenario.ModelSpec()
+    other.source = utils.get_cube_urdf_string()
+    other.source_is_string = True
+    other.name = "other_cube"
+
+    assert not world.insert_models([other, specs[0]])
+    assert not world.insert_models([other, other])
+    assert "other_cube" not in world.model_names()
+    assert len(world.model_names()) == 21
+
+    # A batch with a duplicate name or an invalid source inserts no model
+    first = scenario.ModelSpec()
+    first.source = utils.get_cube_urdf_string()
+    first.source_is_string = True
+    first.name = "first_cube"
+
+    invalid = scenario.ModelSpec()
+    invalid.source = "<robot name='invalid'><link/></robot>"
+    invalid.source_is_string = True
+
+    assert not world.insert_models([first, other, other])
+    assert not world.insert_models([first, other, invalid])
+    assert gazebo.run(paused=True)
+
+    assert "first_cube" not in world.model_names()
+    assert "other_cube" not in world.model_names()
+    assert len(world.model_names()) == 21
+
+    # The names of the rejected batches are still available
+    assert world.insert_models([first, other])
+    assert gazebo.run(paused=True)
+    assert len(world.model_names()) == 23
+
+
+@pytest.mark.parametrize(
+    "gazebo", [(0.001, 1.0, 1)], indirect=True, ids=utils.id_gazebo_fn
+)
+def test_sdf_cache(gazebo: scenario.GazeboSimulator):
+
+    assert gazebo.initialize()
+    world = gazebo.get_world().to_gazebo()
+
+    cube_urdf = utils.get_cube_urdf()
+    scenario.clear_sdf_cache()
+
+    # The first insertion parses the file, the others are served by the cache
+    for idx in range(3):
+        assert world.insert_model(cube_urdf, core.Pose_identity(), f"cube{idx}")
+
+    stats = scenario.sdf_cache_stats()
+    assert stats.misses == 1
+    assert stats.hits == 2
+    assert stats.entries == 1
+
+    # Models loaded from the cache are independent copies
+    assert gazebo.run(paused=True)
+    assert set(world.model_names()) == {"cube0", "cube1", "cube2"}
+
+    # Modified files are parsed again
+    with open(cube_urdf, "a") as f:
+        f.write("\n")
+
+    assert world.insert_model(cube_urdf, core.Pose_identity(), "cube3")
+    assert scenario.sdf_cache_stats().misses == 2
+
+    # Explicit eviction
+    assert scenario.evict_sdf_cache(cube_urdf)
+    assert not scenario.evict_sdf_cache(cube_urdf)
+    assert scenario.sdf_cache_stats().entries == 0
+
+
+def test_physics_substeps():
+
+    model_file = gym_ignition_models.get_model_file("pendulum")
+
+    def simulate(step_size: float, substeps: int, runs: int):
+
+        gazebo = scenario.GazeboSimulator(step_size, 1.0, 1)
+        assert gazebo.initialize()
+
+        world = gazebo.get_world().to_gazebo()
+        assert world.set_physics_engine(scenario.PhysicsEngine_dart, substeps)
+        assert world.insert_model(model_file)
+        assert gazebo.run(paused=True)
+
+        pendulum = world.get_model("pendulum")
+        assert pendulum.get_joint("pivot").to_gazebo().reset_position(0.5)
+
+        # The force command has to be held for all the substeps
+        assert pendulum.set_joint_control_mode(core.JointControlMode_force)
+
+        for _ in range(runs):
+            assert pendulum.set_joint_generalized_force_targets([0.2])
+            assert gazebo.run()
+
+        state = (world.time(), pendulum.joint_positions()[0])
+        gazebo.close()
+
+        return state
+
+    # Four substeps of 1 ms are equivalent to four steps of 1 ms with the
+    # same held command
+    time_substeps, position_substeps = simulate(0.004, 4, 50)
+    time_steps, position_steps = simulate(0.001, 1, 200)
+
+    assert time_substeps == pytest.approx(time_steps)
+    assert position_substeps == pytest.approx(position_steps, abs=1e-6)
+    assert position_substeps != pytest.approx(0.5)
+
+
+def test_physics_sleeping_models():
+
+    gazebo = scenario.GazeboSimulator(0.001, 1.0, 1)
+    assert gazebo.initialize()
+
+    world = gazebo.get_world().to_gazebo()
+
+    # Insert the Physics system with the detection of the models at rest
+    context = (
+        "<sdf version='1.7'>"
+        "<sleep_velocity_threshold>0.01</sleep_velocity_threshold>"
+        "<sleep_steps>50</sleep_steps>"
+        "</sdf>"
+    )
+    assert world.insert_world_plugin(
+        "PhysicsSystem", "scenario::plugins::gazebo::Physics", context
+    )
+
+    assert world.insert_model(gym_ignition_models.get_model_file("ground_plane"))
+    assert world.insert_model(
+        utils.get_cube_urdf(), core.Pose([0, 0, 0.101], [1, 0, 0, 0]), "cube"
+    )
+    assert gazebo.run(paused=True)
+
+    cube = world.get_model("cube").to_gazebo()
+
+    # Let the cube land and rest on the ground long enough to fall asleep
+    for _ in range(500):
+        assert gazebo.run()
+
+    assert cube.base_position()[2] == pytest.approx(0.1, abs=1e-3)
+
+    # The state of a sleeping model is no longer updated
+    position = cube.base_position()
+    velocity = cube.base_world_linear_velocity()
+
+    for _ in range(10):
+        assert gazebo.run()
+        assert cube.base_position() == position
+        assert cube.base_world_linear_velocity() == velocity
+
+    # A wrench wakes the model up
+    link = cube.get_link("cube").to_gazebo()
+    assert link.apply_world_force(
+        force=-2 * np.array(world.gravity()) * cube.total_mass(), duration=0.1
+    )
+
+    for _ in range(100):
+        assert gazebo.run()
+
+    assert cube.base_position()[2] > position[2] + 0.01
+
+    gazebo.close()
+
+
+def test_physics_sleeping_models_moved_by_the_engine():
+
+    gazebo = scenario.GazeboSimulator(0.001, 1.0, 1)
+    assert gazebo.initialize()
+
+    world = gazebo.get_world().to_gazebo()
+
+    # With a weak gravity, a falling model stays below the velocity threshold
+    # long enough to fall asleep, while the engine keeps simulating it
+    assert world.set_gravity((0, 0, -0.01))
+
+    context = (
+        "<sdf version='1.7'>"
+        "<sleep_velocity_threshold>0.01</sleep_velocity_threshold>"
+        "<sleep_steps>50</sleep_steps>"
+        "</sdf>"
+    )
+    assert world.insert_world_plugin(
+        "PhysicsSystem", "scenario::plugins::gazebo::Physics", context
+    )
+
+    assert world.insert_model(
+        utils.get_cube_urdf(), core.Pose([0, 0, 1.0], [1, 0, 0, 0]), "cube"
+    )
+    assert gazebo.run(paused=True)
+
+    cube = world.get_model("cube").to_gazebo()
+
+    # The model falls asleep and its state is no longer updated
+    for _ in range(100):
+        assert gazebo.run()
+
+    position = cube.base_position()
+
+    for _ in range(10):
+        assert gazebo.run()
+        assert cube.base_position() == position
+
+    # The velocity reaches the threshold after one second of fall and the
+    # model is woken up by the motion computed by the engine
+    for _ in range(1500):
+        assert gazebo.run()
+
+    assert cube.base_world_linear_velocity()[2] < -0.01
+    assert cube.base_position()[2] < 1.0 - 0.005
+
+    gazebo.close()
+
+
+@pytest.mark.parametrize("default_world", [(0.001, 1.0, 1)], indirect=True)
+def test_direct_ecm_joint_commands(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Insert a panda model
+    assert world.insert_model(gym_ignition_models.get_model_file("panda"))
+    assert gazebo.run(paused=True)
+
+    panda = world.get_model("panda").to_gazebo()
+    joint1 = panda.get_joint("panda_joint1").to_gazebo()
+    assert joint1.reset_position(0.5)
+    assert gazebo.run(paused=True)
+
+    # The stock controller writes JointForceCmd directly in the ECM, without
+    # enqueueing the joint. Its default target is the zero position.
+    context = (
+        "<sdf version='1.7'>"
+        "<joint_name>panda_joint1</joint_name>"
+        "<p_gain>100</p_gain>"
+        "<d_gain>10</d_gain>"
+        "</sdf>"
+    )
+    assert panda.insert_model_plugin(
+        "ignition-gazebo-joint-position-controller-system",
+        "ignition::gazebo::systems::JointPositionController",
+        context,
+    )
+
+    for _ in range(2_000):
+        assert gazebo.run()
+
+    # The commands of the controller moved the joint towards its target
+    assert joint1.position() == pytest.approx(0.0, abs=0.1)
+
+
+@pytest.mark.parametrize("default_world", [(0.001, 1.0, 1)], indirect=True)
+def test_direct_ecm_joint_commands_from_model_sdf(
+    default_world: Tuple[scenario.GazeboSimulator, scenario.World]
+):
+
+    # Get the simulator and the world
+    gazebo, world = default_world
+
+    # Without gravity the joint moves only if it receives the commands
+    assert world.set_gravity((0, 0, 0))
+
+    # The stock controller is loaded from the SDF of the model and writes
+    # JointForceCmd directly in the ECM. Its default target is the zero
+    # position.
+    model_sdf_string = """<?xml version="1.0" ?>
+    <sdf version="1.7">
+        <model name="pendulum">
+            <link name="base"/>
+            <link name="arm">
+                <pose>0 0 -0.5 0 0 0</pose>
+                <inertial>
+                    <pose>0 0 -0.5 0 0 0</pose>
+                    <mass>1</mass>
+                    <inertia>
+                        <ixx>0.01</ixx>
+                        <iyy>0.01</iyy>
+                        <izz>0.01</izz>
+                    </inertia>
+                </inertial>
+            </link>
+            <joint name="fixed" type="fixed">
+                <parent>world</parent>
+                <child>base</child>
+            </joint>
+            <joint name="pivot" type="revolute">
+                <pose>0 0 0.5 0 0 0</pose>
+                <parent>base</parent>
+                <child>arm</child>
+                <axis>
+                    <xyz>0 1 0</xyz>
+                </axis>
+            </joint>
+            <plugin
+                filename="ignition-gazebo-joint-position-controller-system"
+                name="ignition::gazebo::systems::JointPositionController">
+                <joint_name>pivot</joint_name>
+                <p_gain>10</p_gain>
+                <d_gain>1</d_gain>
+            </plugin>
+        </model>
+    </sdf>"""
+
+    assert world.insert_model_from_string(model_sdf_string)
+    assert gazebo.run(paused=True)
+
+    pendulum = world.get_model("pendulum").to_gazebo()
+    pivot = pendulum.get_joint("pivot").to_gazebo()
+    assert pivot.reset_position(0.5)
+    assert gazebo.run(paused=True)
+
+    for _ in range(2_000):
+        assert gazebo.run()
+
+    # The commands of the controller moved the joint towards its target
+    assert pivot.position() == pytest.approx(0.0, abs=0.1)